@@ -0,0 +1,31 @@
+#include "allocation_counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+////////////////////////////////////////////////////////////
+// allocation counting - replaces global operator new/delete for the whole test executable
+// - kept in its own translation unit: where the malloc/free bodies are visible next to new/delete
+//   expressions, GCC (-Wmismatched-new-delete) reports every such pair as a mismatch
+
+thread_local std::size_t no_of_allocations_in_thread = 0;
+
+void* operator new(std::size_t size)
+{
+    ++no_of_allocations_in_thread;
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,11 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+// number of calls of the global operator new made by the current thread
+// - counted by the replacement of global operator new/delete in allocation_counter.cpp,
+//   which is linked into the test executables that include this header
+extern thread_local std::size_t no_of_allocations_in_thread;
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef CACHE_LINE_HPP
+#define CACHE_LINE_HPP
+
+#include <cstddef>
+
+// size of a cache line - data written by different threads is aligned to it to avoid false sharing
+// - fixed value instead of std::hardware_destructive_interference_size, which may differ between
+//   compiler flags & would change the layout of the classes that use it (GCC warns: -Winterference-size)
+constexpr std::size_t cache_line_size = 64;
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef ASYNC_NOTIFIER_HPP
+#define ASYNC_NOTIFIER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "temp_monitor.hpp"
+
+enum class OverflowPolicy
+{
+    drop_newest, // new event is discarded
+    drop_oldest, // the oldest queued event is overwritten - observer always gets the latest value
+    block        // backpressure - notify() waits until there is room
+};
+
+struct DeliveryOptions
+{
+    std::size_t queue_depth = 1024;
+    OverflowPolicy overflow = OverflowPolicy::drop_oldest;
+    std::size_t max_batch_size = 64;
+};
+
+struct DeliveryStats
+{
+    std::uint64_t delivered;
+    std::uint64_t dropped;
+};
+
+// Asynchronous notifications for TempMonitor observers
+// - notify() only copies the reading into a bounded ring per observer - its cost does not depend
+//   on how slow the observers are (except for OverflowPolicy::block)
+// - every observer has its own worker thread that delivers queued events in batches
+//   (a kernel thread & its stack per subscription - meant for a few observers, not for thousands)
+// - events notified after stop() are dropped
+// - subscribe() must not run concurrently with notify()
+class AsyncNotifier
+{
+    struct Event
+    {
+        TempMonitor* sender;
+        double temp;
+    };
+
+    class Subscription
+    {
+        Observer& observer_;
+        const DeliveryOptions options_;
+
+        std::vector<Event> ring_;
+        std::size_t head_ = 0;
+        std::size_t size_ = 0;
+        bool is_delivering_ = false;
+        bool is_stopped_ = false;
+        bool is_worker_waiting_ = false;
+        DeliveryStats stats_{0, 0};
+
+        std::mutex mtx_;
+        std::condition_variable cv_not_empty_;
+        std::condition_variable cv_not_full_or_idle_;
+        std::thread worker_;
+
+        void run()
+        {
+            std::vector<Event> batch;
+            batch.reserve(options_.max_batch_size);
+
+            while (true)
+            {
+                {
+                    std::unique_lock lk{mtx_};
+
+                    stats_.delivered += batch.size(); // update() has returned for the whole batch
+                    is_delivering_ = false;
+                    if (size_ == 0)
+                        cv_not_full_or_idle_.notify_all();
+
+                    is_worker_waiting_ = true;
+                    cv_not_empty_.wait(lk, [this] { return size_ != 0 || is_stopped_; });
+                    is_worker_waiting_ = false;
+
+                    if (size_ == 0)
+                        return; // stopped & all delivered
+
+                    batch.clear();
+                    while (size_ != 0 && batch.size() < options_.max_batch_size)
+                    {
+                        batch.push_back(ring_[head_]);
+                        head_ = (head_ + 1) % ring_.size();
+                        --size_;
+                    }
+
+                    is_delivering_ = true;
+                }
+
+                cv_not_full_or_idle_.notify_all();
+
+                for (const auto& event : batch)
+                    observer_.update(event.sender, std::to_string(event.temp));
+            }
+        }
+
+    public:
+        Subscription(Observer& observer, const DeliveryOptions& options)
+            : observer_{observer}
+            , options_{options}
+            , ring_(options.queue_depth < 1 ? 1 : options.queue_depth)
+        {
+            worker_ = std::thread{&Subscription::run, this};
+        }
+
+        ~Subscription()
+        {
+            stop();
+        }
+
+        void push(const Event& event)
+        {
+            bool notify_worker;
+
+            {
+                std::unique_lock lk{mtx_};
+
+                if (is_stopped_)
+                {
+                    ++stats_.dropped;
+                    return;
+                }
+
+                if (size_ == ring_.size())
+                {
+                    switch (options_.overflow)
+                    {
+                    case OverflowPolicy::drop_newest:
+                        ++stats_.dropped;
+                        return;
+                    case OverflowPolicy::drop_oldest:
+                        head_ = (head_ + 1) % ring_.size();
+                        --size_;
+                        ++stats_.dropped;
+                        break;
+                    case OverflowPolicy::block:
+                        cv_not_full_or_idle_.wait(lk, [this] { return size_ < ring_.size() || is_stopped_; });
+                        if (is_stopped_)
+                        {
+                            ++stats_.dropped;
+                            return;
+                        }
+                        break;
+                    }
+                }
+
+                ring_[(head_ + size_) % ring_.size()] = event;
+                ++size_;
+                notify_worker = is_worker_waiting_;
+            }
+
+            if (notify_worker)
+                cv_not_empty_.notify_one();
+        }
+
+        void wait_until_idle()
+        {
+            std::unique_lock lk{mtx_};
+            cv_not_full_or_idle_.wait(lk, [this] { return size_ == 0 && !is_delivering_; });
+        }
+
+        // delivers all queued events & stops the worker
+        void stop()
+        {
+            {
+                std::lock_guard lk{mtx_};
+                is_stopped_ = true;
+            }
+            cv_not_empty_.notify_one();
+            cv_not_full_or_idle_.notify_all(); // producers blocked on a full ring
+
+            if (worker_.joinable())
+                worker_.join();
+        }
+
+        const Observer& observer() const
+        {
+            return observer_;
+        }
+
+        DeliveryStats stats()
+        {
+            std::lock_guard lk{mtx_};
+            return stats_;
+        }
+    };
+
+    std::vector<std::unique_ptr<Subscription>> subscriptions_;
+
+public:
+    AsyncNotifier() = default;
+    AsyncNotifier(const AsyncNotifier&) = delete;
+    AsyncNotifier& operator=(const AsyncNotifier&) = delete;
+
+    void subscribe(Observer& observer, const DeliveryOptions& options = DeliveryOptions{})
+    {
+        subscriptions_.push_back(std::make_unique<Subscription>(observer, options));
+    }
+
+    void notify(TempMonitor& monitor)
+    {
+        const Event event{&monitor, monitor.get_temp()};
+
+        for (const auto& subscription : subscriptions_)
+            subscription->push(event);
+    }
+
+    // waits until all queued events are delivered
+    void wait_until_idle()
+    {
+        for (const auto& subscription : subscriptions_)
+            subscription->wait_until_idle();
+    }
+
+    // delivers all queued events and stops the workers
+    void stop()
+    {
+        for (const auto& subscription : subscriptions_)
+            subscription->stop();
+    }
+
+    DeliveryStats stats(const Observer& observer) const
+    {
+        for (const auto& subscription : subscriptions_)
+            if (&subscription->observer() == &observer)
+                return subscription->stats();
+
+        return DeliveryStats{0, 0};
+    }
+};
+
+#endif
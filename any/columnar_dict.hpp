@@ -0,0 +1,178 @@
+#ifndef COLUMNAR_DICT_HPP
+#define COLUMNAR_DICT_HPP
+
+#include <any>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dynamic_dict.hpp"
+#include "flat_hash_map.hpp"
+#include "type_index.hpp"
+
+// DynamicDict with type-segregated storage
+// - values of the same type are stored together in a dense column (std::vector<T>)
+// - a key maps to (column, slot) - get<T> checks the column index & reads column[slot]
+// - all values of one type can be scanned sequentially with values<T>()
+class ColumnarDict
+{
+public:
+    struct Location
+    {
+        std::size_t column;
+        std::size_t slot;
+    };
+
+private:
+    struct ColumnBase
+    {
+        std::vector<std::string_view> keys;
+
+        virtual ~ColumnBase() = default;
+        virtual std::unique_ptr<ColumnBase> clone() const = 0;
+    };
+
+    template <typename T>
+    struct Column : ColumnBase
+    {
+        std::vector<T> values;
+
+        std::unique_ptr<ColumnBase> clone() const override
+        {
+            return std::make_unique<Column>(*this);
+        }
+    };
+
+    KeyStorage keys_;
+    FlatHashMap<std::string_view, Location> index_;
+    std::vector<std::unique_ptr<ColumnBase>> columns_; // indexed by column_index<T>()
+
+    template <typename T>
+    static std::size_t column_index()
+    {
+        return Detail::DenseTypeIndex<ColumnarDict>::of<T>();
+    }
+
+    template <typename T>
+    const Column<T>* column_of() const
+    {
+        const auto column = column_index<T>();
+        return column < columns_.size() ? static_cast<const Column<T>*>(columns_[column].get()) : nullptr;
+    }
+
+    template <typename T>
+    Column<T>* column_of()
+    {
+        return const_cast<Column<T>*>(std::as_const(*this).template column_of<T>());
+    }
+
+    template <typename T>
+    Column<T>& column_for_insert()
+    {
+        const auto column = column_index<T>();
+        if (column >= columns_.size())
+            columns_.resize(column + 1);
+        if (!columns_[column])
+            columns_[column] = std::make_unique<Column<T>>();
+
+        return static_cast<Column<T>&>(*columns_[column]);
+    }
+
+public:
+    ColumnarDict() = default;
+
+    // the copy stores its own keys - index & columns are rebuilt to view them
+    ColumnarDict(const ColumnarDict& other)
+    {
+        index_.reserve(other.size());
+        columns_.reserve(other.columns_.size());
+
+        for (std::size_t column = 0; column < other.columns_.size(); ++column)
+        {
+            auto& copy = columns_.emplace_back(other.columns_[column] ? other.columns_[column]->clone() : nullptr);
+            if (!copy)
+                continue;
+
+            for (std::size_t slot = 0; slot < copy->keys.size(); ++slot)
+            {
+                copy->keys[slot] = keys_.store(copy->keys[slot]);
+                index_.emplace(copy->keys[slot], Location{column, slot});
+            }
+        }
+    }
+
+    ColumnarDict& operator=(const ColumnarDict& other)
+    {
+        if (this != &other)
+            *this = ColumnarDict(other);
+        return *this;
+    }
+
+    ColumnarDict(ColumnarDict&&) noexcept = default;
+    ColumnarDict& operator=(ColumnarDict&&) noexcept = default;
+
+    template <typename T>
+    auto insert(std::string_view key, T&& value)
+    {
+        using TValue = std::decay_t<T>;
+
+        if (auto pos = index_.find(key); pos != index_.end())
+            return std::pair{pos, false};
+
+        auto& column = column_for_insert<TValue>();
+        const auto stored_key = keys_.store(key);
+
+        column.values.push_back(std::forward<T>(value));
+        column.keys.push_back(stored_key);
+
+        return index_.emplace(stored_key, Location{column_index<TValue>(), column.values.size() - 1});
+    }
+
+    bool contains(std::string_view key) const
+    {
+        return index_.find(key) != index_.end();
+    }
+
+    std::size_t size() const
+    {
+        return index_.size();
+    }
+
+    // throws std::out_of_range for unknown key & std::bad_any_cast for a value of another type
+    template <typename T>
+    T get(std::string_view key)
+    {
+        using TValue = std::remove_cv_t<std::remove_reference_t<T>>;
+
+        const Location location = index_.at(key);
+        if (location.column != column_index<TValue>())
+            throw std::bad_any_cast{};
+
+        return static_cast<T>(column_of<TValue>()->values[location.slot]);
+    }
+
+    // all values of type T in insertion order
+    template <typename T>
+    const std::vector<T>& values() const
+    {
+        static const std::vector<T> no_values;
+
+        auto* column = column_of<T>();
+        return column ? column->values : no_values;
+    }
+
+    // keys of values<T>() - keys<T>()[i] is the key of values<T>()[i]
+    template <typename T>
+    const std::vector<std::string_view>& keys() const
+    {
+        static const std::vector<std::string_view> no_keys;
+
+        auto* column = column_of<T>();
+        return column ? column->keys : no_keys;
+    }
+};
+
+#endif
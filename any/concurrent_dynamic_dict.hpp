@@ -0,0 +1,196 @@
+#ifndef CONCURRENT_DYNAMIC_DICT_HPP
+#define CONCURRENT_DYNAMIC_DICT_HPP
+
+#include <any>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "cache_line.hpp"
+
+// DynamicDict that can be shared by many threads (insert-only, like DynamicDict)
+// - keys are spread over shards; inserts lock only their shard (every entry owns its key - no shared key pool)
+// - get<T> is lock-free: a shard is an open-addressing table of atomic pointers to immutable entries,
+//   published with release stores - readers do only acquire loads (no RMW, no shared cache line writes)
+// - a full table is replaced by a bigger copy; old tables stay alive (readers may still probe them)
+//   until the dictionary is destroyed - at most as much memory as the current tables
+template <typename TAny = std::any>
+class BasicConcurrentDynamicDict
+{
+public:
+    using value_type = std::pair<const std::string_view, const TAny>;
+
+private:
+    static constexpr std::size_t no_of_shards = 64;
+    static constexpr std::size_t shard_bits = 6;
+    static constexpr std::size_t min_capacity = 16;
+
+    struct Entry
+    {
+        const std::string key; // owned by the entry - entry.first views it
+        value_type entry;
+        std::size_t hash;
+
+        Entry(std::string_view key, TAny value, std::size_t hash)
+            : key{key}
+            , entry{this->key, std::move(value)}
+            , hash{hash}
+        {
+        }
+
+        Entry(const Entry&) = delete;
+        Entry& operator=(const Entry&) = delete;
+    };
+
+    struct Table
+    {
+        std::size_t capacity; // power of 2
+        std::unique_ptr<std::atomic<Entry*>[]> slots;
+
+        explicit Table(std::size_t capacity)
+            : capacity{capacity}
+            , slots{new std::atomic<Entry*>[capacity]}
+        {
+            for (std::size_t i = 0; i < capacity; ++i)
+                slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+    };
+
+    struct Shard
+    {
+        alignas(cache_line_size) std::atomic<Table*> table{nullptr}; // read by get() - kept apart from writer state
+        alignas(cache_line_size) std::mutex mtx_writers;
+        std::size_t size = 0;
+        std::vector<std::unique_ptr<Table>> tables; // current & retired tables
+    };
+
+    std::array<Shard, no_of_shards> shards_;
+
+    static std::size_t hash_of(std::string_view key)
+    {
+        return std::hash<std::string_view>{}(key);
+    }
+
+    static std::size_t shard_index(std::size_t hash)
+    {
+        return hash >> (sizeof(std::size_t) * 8 - shard_bits);
+    }
+
+    static Entry* find(const Table* table, std::string_view key, std::size_t hash)
+    {
+        if (!table)
+            return nullptr;
+
+        const auto mask = table->capacity - 1;
+        for (auto index = hash & mask;; index = (index + 1) & mask)
+        {
+            Entry* entry = table->slots[index].load(std::memory_order_acquire);
+            if (!entry)
+                return nullptr;
+            if (entry->hash == hash && entry->entry.first == key)
+                return entry;
+        }
+    }
+
+    static void insert_unique(Table& table, Entry* entry)
+    {
+        const auto mask = table.capacity - 1;
+        auto index = entry->hash & mask;
+        while (table.slots[index].load(std::memory_order_relaxed))
+            index = (index + 1) & mask;
+
+        table.slots[index].store(entry, std::memory_order_release);
+    }
+
+    // caller must hold shard.mtx_writers
+    static Table& table_for_insert(Shard& shard)
+    {
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        if (table && (shard.size + 1) * 2 <= table->capacity) // max. load factor 1/2
+            return *table;
+
+        auto bigger_table = std::make_unique<Table>(table ? table->capacity * 2 : min_capacity);
+        if (table)
+        {
+            for (std::size_t i = 0; i < table->capacity; ++i)
+                if (Entry* entry = table->slots[i].load(std::memory_order_relaxed))
+                    insert_unique(*bigger_table, entry);
+        }
+
+        // owned by shard.tables before readers can see it - push_back may throw
+        shard.tables.push_back(std::move(bigger_table));
+        shard.table.store(shard.tables.back().get(), std::memory_order_release);
+
+        return *shard.tables.back();
+    }
+
+public:
+    BasicConcurrentDynamicDict() = default;
+    BasicConcurrentDynamicDict(const BasicConcurrentDynamicDict&) = delete;
+    BasicConcurrentDynamicDict& operator=(const BasicConcurrentDynamicDict&) = delete;
+
+    ~BasicConcurrentDynamicDict()
+    {
+        for (auto& shard : shards_)
+        {
+            if (Table* table = shard.table.load())
+            {
+                for (std::size_t i = 0; i < table->capacity; ++i)
+                    delete table->slots[i].load();
+            }
+        }
+    }
+
+    // returns (pointer to the key/value pair, inserted) - the pair stays valid as long as the dictionary
+    std::pair<const value_type*, bool> insert(std::string_view key, TAny value)
+    {
+        const auto hash = hash_of(key);
+        Shard& shard = shards_[shard_index(hash)];
+
+        std::lock_guard lk{shard.mtx_writers};
+
+        if (Entry* entry = find(shard.table.load(std::memory_order_relaxed), key, hash))
+            return {&entry->entry, false};
+
+        Table& table = table_for_insert(shard);
+        auto* entry = new Entry{key, std::move(value), hash};
+        insert_unique(table, entry);
+        ++shard.size;
+
+        return {&entry->entry, true};
+    }
+
+    bool contains(std::string_view key) const
+    {
+        const auto hash = hash_of(key);
+        const Shard& shard = shards_[shard_index(hash)];
+
+        return find(shard.table.load(std::memory_order_acquire), key, hash) != nullptr;
+    }
+
+    template <typename T>
+    T get(std::string_view key) const
+    {
+        const auto hash = hash_of(key);
+        const Shard& shard = shards_[shard_index(hash)];
+
+        const Entry* entry = find(shard.table.load(std::memory_order_acquire), key, hash);
+        if (!entry)
+            throw std::out_of_range("key not found: " + std::string{key});
+
+        using std::any_cast;
+        return any_cast<T>(entry->entry.second);
+    }
+};
+
+using ConcurrentDynamicDict = BasicConcurrentDynamicDict<std::any>;
+
+#endif
@@ -0,0 +1,487 @@
+#ifndef DICT_SNAPSHOT_HPP
+#define DICT_SNAPSHOT_HPP
+
+#include <any>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "dynamic_dict.hpp"
+#include "schema_dict.hpp"
+
+////////////////////////////////////////////////////////////
+// value types that can be stored in a snapshot
+// - type_id - stored in the file, must never change
+// - bytes(value) - contiguous representation of a value; read(data, size) - value from the mapped bytes
+
+template <typename T>
+struct SnapshotTraits; // not registered
+
+template <typename T>
+struct ScalarSnapshotTraits
+{
+    static std::string_view bytes(const T& value)
+    {
+        return {reinterpret_cast<const char*>(&value), sizeof(T)};
+    }
+
+    static T read(const char* data, std::size_t size)
+    {
+        if (size != sizeof(T))
+            throw std::runtime_error("corrupt dictionary snapshot - invalid value size");
+
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+};
+
+template <typename T>
+struct VectorSnapshotTraits
+{
+    static std::string_view bytes(const std::vector<T>& values)
+    {
+        return {reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T)};
+    }
+
+    static std::vector<T> read(const char* data, std::size_t size)
+    {
+        if (size % sizeof(T) != 0)
+            throw std::runtime_error("corrupt dictionary snapshot - invalid value size");
+
+        std::vector<T> values(size / sizeof(T));
+        std::memcpy(values.data(), data, size);
+        return values;
+    }
+};
+
+template <>
+struct SnapshotTraits<int> : ScalarSnapshotTraits<int>
+{
+    static constexpr std::uint32_t type_id = 1;
+};
+
+template <>
+struct SnapshotTraits<std::int64_t> : ScalarSnapshotTraits<std::int64_t>
+{
+    static constexpr std::uint32_t type_id = 2;
+};
+
+template <>
+struct SnapshotTraits<double> : ScalarSnapshotTraits<double>
+{
+    static constexpr std::uint32_t type_id = 3;
+};
+
+template <>
+struct SnapshotTraits<std::string>
+{
+    static constexpr std::uint32_t type_id = 4;
+
+    static std::string_view bytes(const std::string& value)
+    {
+        return value;
+    }
+
+    static std::string read(const char* data, std::size_t size)
+    {
+        return std::string(data, size);
+    }
+};
+
+// strings can be read in place - view into the mapped file
+template <>
+struct SnapshotTraits<std::string_view>
+{
+    static constexpr std::uint32_t type_id = SnapshotTraits<std::string>::type_id;
+
+    static std::string_view read(const char* data, std::size_t size)
+    {
+        return std::string_view(data, size);
+    }
+};
+
+template <>
+struct SnapshotTraits<std::vector<int>> : VectorSnapshotTraits<int>
+{
+    static constexpr std::uint32_t type_id = 5;
+};
+
+template <>
+struct SnapshotTraits<std::vector<double>> : VectorSnapshotTraits<double>
+{
+    static constexpr std::uint32_t type_id = 6;
+};
+
+// types tried (in order) when a dictionary is saved
+using SnapshotValueTypes = std::tuple<int, std::int64_t, double, std::string, std::vector<int>, std::vector<double>>;
+
+namespace Detail
+{
+    // file layout (native byte order):
+    //   SnapshotHeader | entries | hash table (table_capacity x uint64 entry offsets, 0 - empty slot)
+    // entry: SnapshotEntry | key | padding to 8 | value | padding to 8
+    struct SnapshotHeader
+    {
+        char magic[8];
+        std::uint64_t version;
+        std::uint64_t no_of_entries;
+        std::uint64_t table_capacity; // power of 2
+        std::uint64_t table_offset;
+    };
+
+    struct SnapshotEntry
+    {
+        std::uint64_t hash;
+        std::uint32_t key_size;
+        std::uint32_t type_id;
+        std::uint64_t value_size;
+    };
+
+    constexpr char snapshot_magic[8] = {'D', 'I', 'C', 'T', 'S', 'N', 'A', 'P'};
+    constexpr std::uint64_t snapshot_version = 1; // must change with every change of the file layout
+
+    constexpr std::uint64_t aligned_to_8(std::uint64_t size) noexcept
+    {
+        return (size + 7) & ~std::uint64_t{7};
+    }
+
+    template <typename TAny, typename TVisitor, typename... Ts>
+    bool visit_snapshot_value(const TAny& value, TVisitor&& visitor, std::tuple<Ts...>*)
+    {
+        using std::any_cast;
+        return ((any_cast<Ts>(&value) ? (visitor(*any_cast<Ts>(&value)), true) : false) || ...);
+    }
+
+    // buffered writes to a file descriptor - throws std::system_error on failure
+    class SnapshotWriter
+    {
+        static constexpr std::size_t buffer_capacity = 64 * 1024;
+
+        int fd_;
+        const std::string& path_;
+        std::vector<char> buffer_;
+
+        [[noreturn]] void throw_write_error() const
+        {
+            throw std::system_error(errno, std::generic_category(), "cannot write snapshot " + path_);
+        }
+
+    public:
+        SnapshotWriter(int fd, const std::string& path)
+            : fd_{fd}
+            , path_{path}
+        {
+            buffer_.reserve(buffer_capacity);
+        }
+
+        void write(const char* data, std::size_t size)
+        {
+            if (buffer_.size() + size > buffer_capacity)
+                flush();
+            buffer_.insert(buffer_.end(), data, data + size);
+        }
+
+        void flush()
+        {
+            for (std::size_t written = 0; written < buffer_.size();)
+            {
+                const auto result = ::write(fd_, buffer_.data() + written, buffer_.size() - written);
+                if (result == -1 && errno != EINTR)
+                    throw_write_error();
+                if (result > 0)
+                    written += static_cast<std::size_t>(result);
+            }
+            buffer_.clear();
+        }
+
+        // overwrites already flushed bytes
+        void write_at(std::uint64_t offset, const char* data, std::size_t size)
+        {
+            for (std::size_t written = 0; written < size;)
+            {
+                const auto result = ::pwrite(fd_, data + written, size - written, static_cast<off_t>(offset + written));
+                if (result == -1 && errno != EINTR)
+                    throw_write_error();
+                if (result > 0)
+                    written += static_cast<std::size_t>(result);
+            }
+        }
+    };
+
+    template <typename TAny, template <typename...> class TMap>
+    void write_snapshot(const BasicDynamicDict<TAny, TMap>& dict, int fd, const std::string& path)
+    {
+        std::uint64_t table_capacity = 1;
+        while (table_capacity < 2 * dict.size())
+            table_capacity *= 2;
+        std::vector<std::uint64_t> table(table_capacity);
+
+        SnapshotWriter out{fd, path};
+
+        SnapshotHeader header{};
+        std::memcpy(header.magic, snapshot_magic, sizeof(snapshot_magic));
+        header.version = snapshot_version;
+        header.no_of_entries = dict.size();
+        header.table_capacity = table_capacity;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        std::uint64_t offset = sizeof(header);
+        const char padding[8] = {};
+
+        auto write_padded = [&](std::string_view bytes) {
+            out.write(bytes.data(), bytes.size());
+            const auto padded_size = aligned_to_8(bytes.size());
+            out.write(padding, padded_size - bytes.size());
+            offset += padded_size;
+        };
+
+        for (const auto& [key, value] : dict)
+        {
+            const bool is_registered = visit_snapshot_value(
+                value,
+                [&, &key = key](const auto& v) {
+                    using Traits = SnapshotTraits<std::decay_t<decltype(v)>>;
+
+                    const auto bytes = Traits::bytes(v);
+                    const SnapshotEntry entry{fnv1a(key), static_cast<std::uint32_t>(key.size()), Traits::type_id, bytes.size()};
+
+                    auto slot = entry.hash & (table_capacity - 1);
+                    while (table[slot] != 0)
+                        slot = (slot + 1) & (table_capacity - 1);
+                    table[slot] = offset;
+
+                    out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+                    offset += sizeof(entry);
+                    write_padded(key);
+                    write_padded(bytes);
+                },
+                static_cast<SnapshotValueTypes*>(nullptr));
+
+            if (!is_registered)
+                throw std::invalid_argument("cannot save value of unregistered type for key: " + std::string{key});
+        }
+
+        header.table_offset = offset;
+        out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(std::uint64_t));
+        out.flush();
+        out.write_at(0, reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+}
+
+// writes a snapshot of the dictionary - throws std::invalid_argument for values of unregistered types
+// - the file is written under a unique temporary name (path.XXXXXX), synced to disk & renamed - readers
+//   never see a partially written snapshot (& snapshots already mapped keep the old contents),
+//   concurrent saves to the same path do not write into each other's file
+template <typename TAny, template <typename...> class TMap>
+void save_snapshot(const BasicDynamicDict<TAny, TMap>& dict, const std::string& path)
+{
+    std::string temp_path = path + ".XXXXXX";
+
+    const int fd = ::mkstemp(temp_path.data());
+    if (fd == -1)
+        throw std::system_error(errno, std::generic_category(), "cannot create snapshot " + path);
+
+    try
+    {
+        Detail::write_snapshot(dict, fd, temp_path);
+
+        // mkstemp creates the file readable only by its owner
+        if (::fchmod(fd, 0644) != 0 || ::fsync(fd) != 0)
+            throw std::system_error(errno, std::generic_category(), "cannot write snapshot " + temp_path);
+    }
+    catch (...)
+    {
+        ::close(fd);
+        ::unlink(temp_path.c_str());
+        throw;
+    }
+
+    if (::close(fd) != 0)
+    {
+        const auto error = errno;
+        ::unlink(temp_path.c_str());
+        throw std::system_error(error, std::generic_category(), "cannot write snapshot " + temp_path);
+    }
+
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+    {
+        const auto error = errno;
+        ::unlink(temp_path.c_str());
+        throw std::system_error(error, std::generic_category(), "cannot replace snapshot " + path);
+    }
+}
+
+// read-only dictionary backed by a memory-mapped snapshot file (POSIX)
+// - opening maps the file - no parsing, no per-entry work; the hash index is part of the file
+// - scalars & strings are read directly from the mapping (get<std::string_view> does not copy)
+class DictSnapshot
+{
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+    const Detail::SnapshotHeader* header_ = nullptr;
+    const std::uint64_t* table_ = nullptr;
+
+    [[noreturn]] static void throw_system_error(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    const char* data() const noexcept
+    {
+        return static_cast<const char*>(mapping_);
+    }
+
+    [[noreturn]] static void throw_corrupt()
+    {
+        throw std::runtime_error("corrupt dictionary snapshot");
+    }
+
+    // entry at the offset - the entry, its key & its value must lie between the header & the table
+    const Detail::SnapshotEntry* entry_at(std::uint64_t offset) const
+    {
+        using Detail::SnapshotEntry;
+
+        const auto entries_end = header_->table_offset;
+        if (offset < sizeof(Detail::SnapshotHeader) || offset % alignof(SnapshotEntry) != 0 || offset > entries_end
+            || entries_end - offset < sizeof(SnapshotEntry))
+            throw_corrupt();
+
+        const auto* entry = reinterpret_cast<const SnapshotEntry*>(data() + offset);
+        const auto available = entries_end - offset - sizeof(SnapshotEntry);
+        const auto key_size = Detail::aligned_to_8(entry->key_size);
+        if (key_size > available || entry->value_size > available - key_size)
+            throw_corrupt();
+
+        return entry;
+    }
+
+    // throws std::runtime_error if a probed entry is corrupt
+    const Detail::SnapshotEntry* find(std::string_view key) const
+    {
+        const auto hash = Detail::fnv1a(key);
+        const auto capacity = header_->table_capacity;
+        const auto mask = capacity - 1;
+
+        auto slot = hash & mask;
+        for (std::uint64_t probe = 0; probe < capacity && table_[slot] != 0; ++probe, slot = (slot + 1) & mask)
+        {
+            const auto* entry = entry_at(table_[slot]);
+            if (entry->hash == hash && key_of(*entry) == key)
+                return entry;
+        }
+
+        return nullptr;
+    }
+
+    static std::string_view key_of(const Detail::SnapshotEntry& entry) noexcept
+    {
+        return {reinterpret_cast<const char*>(&entry + 1), entry.key_size};
+    }
+
+    static const char* value_of(const Detail::SnapshotEntry& entry) noexcept
+    {
+        return reinterpret_cast<const char*>(&entry + 1) + Detail::aligned_to_8(entry.key_size);
+    }
+
+public:
+    explicit DictSnapshot(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            throw_system_error("cannot open snapshot " + path);
+
+        struct stat file_stat{};
+        if (::fstat(fd, &file_stat) != 0)
+        {
+            ::close(fd);
+            throw_system_error("cannot stat snapshot " + path);
+        }
+
+        mapping_size_ = static_cast<std::size_t>(file_stat.st_size);
+        if (mapping_size_ < sizeof(Detail::SnapshotHeader))
+        {
+            ::close(fd);
+            throw std::runtime_error("not a dictionary snapshot: " + path);
+        }
+
+        mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping_ == MAP_FAILED)
+        {
+            mapping_ = nullptr;
+            throw_system_error("cannot map snapshot " + path);
+        }
+
+        header_ = static_cast<const Detail::SnapshotHeader*>(mapping_);
+        const auto table_capacity = header_->table_capacity;
+
+        if (std::memcmp(header_->magic, Detail::snapshot_magic, sizeof(Detail::snapshot_magic)) == 0
+            && header_->version != Detail::snapshot_version)
+        {
+            ::munmap(mapping_, mapping_size_);
+            throw std::runtime_error("unsupported dictionary snapshot version: " + path);
+        }
+
+        if (std::memcmp(header_->magic, Detail::snapshot_magic, sizeof(Detail::snapshot_magic)) != 0
+            || table_capacity == 0 || (table_capacity & (table_capacity - 1)) != 0
+            || header_->table_offset % alignof(std::uint64_t) != 0
+            || header_->table_offset > mapping_size_ || (mapping_size_ - header_->table_offset) / sizeof(std::uint64_t) < table_capacity)
+        {
+            ::munmap(mapping_, mapping_size_);
+            throw std::runtime_error("not a dictionary snapshot: " + path);
+        }
+
+        table_ = reinterpret_cast<const std::uint64_t*>(data() + header_->table_offset);
+    }
+
+    DictSnapshot(const DictSnapshot&) = delete;
+    DictSnapshot& operator=(const DictSnapshot&) = delete;
+
+    ~DictSnapshot()
+    {
+        ::munmap(mapping_, mapping_size_);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return header_->no_of_entries;
+    }
+
+    bool contains(std::string_view key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    // throws std::out_of_range for unknown key, std::bad_any_cast for a value of another type
+    // & std::runtime_error for a corrupt entry
+    template <typename T>
+    T get(std::string_view key) const
+    {
+        using Traits = SnapshotTraits<std::remove_cv_t<T>>;
+
+        const auto* entry = find(key);
+        if (!entry)
+            throw std::out_of_range("key not found in snapshot: " + std::string{key});
+        if (entry->type_id != Traits::type_id)
+            throw std::bad_any_cast{};
+
+        return Traits::read(value_of(*entry), entry->value_size);
+    }
+};
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef DYNAMIC_DICT_HPP
+#define DYNAMIC_DICT_HPP
+
+#include <any>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+// keys of one dictionary - stored strings never move, so the dictionary can use std::string_view keys
+// (freed together with the dictionary; a copy of the dictionary stores its own keys)
+class KeyStorage
+{
+    std::deque<std::string> keys_; // deque - stored strings never move (also when the deque is moved)
+
+public:
+    std::string_view store(std::string_view key)
+    {
+        return keys_.emplace_back(key);
+    }
+
+    std::size_t size() const
+    {
+        return keys_.size();
+    }
+};
+
+// TAny - std::any or any type with the same interface & any_cast found by ADL (e.g. inplace_any)
+// TMap - std::unordered_map or any map with the same find/emplace/at interface (e.g. FlatHashMap)
+// keys are stored once in the dictionary's KeyStorage - lookups by std::string_view, literals or std::string never allocate
+template <typename TAny, template <typename...> class TMap = std::unordered_map>
+class BasicDynamicDict
+{
+    KeyStorage keys_;
+    TMap<std::string_view, TAny> dict_;
+public:
+    BasicDynamicDict() = default;
+
+    BasicDynamicDict(const BasicDynamicDict& other)
+    {
+        for (const auto& [key, value] : other.dict_)
+            dict_.emplace(keys_.store(key), value);
+    }
+
+    BasicDynamicDict& operator=(const BasicDynamicDict& other)
+    {
+        if (this != &other)
+            *this = BasicDynamicDict(other);
+        return *this;
+    }
+
+    BasicDynamicDict(BasicDynamicDict&&) = default;
+    BasicDynamicDict& operator=(BasicDynamicDict&&) = default;
+
+    auto insert(std::string_view key, TAny value)
+    {
+        if (auto pos = dict_.find(key); pos != dict_.end())
+            return std::pair{pos, false};
+
+        return dict_.emplace(keys_.store(key), std::move(value));
+    }
+
+    bool contains(std::string_view key) const
+    {
+        return dict_.find(key) != dict_.end();
+    }
+
+    std::size_t size() const
+    {
+        return dict_.size();
+    }
+
+    auto begin() const
+    {
+        return dict_.begin();
+    }
+
+    auto end() const
+    {
+        return dict_.end();
+    }
+
+    template <typename T>
+    T get(std::string_view key)
+    {
+        using std::any_cast;
+        return any_cast<T>(dict_.at(key));
+    }
+};
+
+using DynamicDict = BasicDynamicDict<std::any>;
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef EVENT_BUS_HPP
+#define EVENT_BUS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "type_index.hpp"
+
+// Typed event bus - narrow interfaces instead of Observer::update(std::any, const std::string&)
+// - an observer subscribes to concrete event types and is called with on(const TEvent&)
+// - publish() does no heap allocation, no std::any & no type checks at run time
+// - subscribe/unsubscribe may allocate and must not run concurrently with publish()
+class EventBus
+{
+    struct Subscriber
+    {
+        void* observer;
+        void (*handler)(void* observer, const void* event);
+    };
+
+    std::vector<std::vector<Subscriber>> subscribers_; // indexed by event type
+
+    template <typename TEvent>
+    std::vector<Subscriber>* subscribers_of()
+    {
+        const auto index = Detail::DenseTypeIndex<EventBus>::of<TEvent>();
+        return index < subscribers_.size() ? &subscribers_[index] : nullptr;
+    }
+
+public:
+    template <typename TEvent, typename TObserver>
+    void subscribe(TObserver& observer)
+    {
+        const auto index = Detail::DenseTypeIndex<EventBus>::of<TEvent>();
+        if (index >= subscribers_.size())
+            subscribers_.resize(index + 1);
+
+        subscribers_[index].push_back(Subscriber{&observer, [](void* observer, const void* event) {
+                                                     static_cast<TObserver*>(observer)->on(*static_cast<const TEvent*>(event));
+                                                 }});
+    }
+
+    template <typename TEvent, typename TObserver>
+    void unsubscribe(TObserver& observer)
+    {
+        if (auto* subscribers = subscribers_of<TEvent>())
+        {
+            subscribers->erase(std::remove_if(subscribers->begin(), subscribers->end(), [&observer](const Subscriber& s) { return s.observer == &observer; }),
+                subscribers->end());
+        }
+    }
+
+    template <typename TEvent>
+    std::size_t no_of_subscribers()
+    {
+        const auto* subscribers = subscribers_of<TEvent>();
+        return subscribers ? subscribers->size() : 0;
+    }
+
+    template <typename TEvent>
+    void publish(const TEvent& event)
+    {
+        if (auto* subscribers = subscribers_of<TEvent>())
+        {
+            for (const auto& s : *subscribers)
+                s.handler(s.observer, &event);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,418 @@
+#ifndef FLAT_HASH_MAP_HPP
+#define FLAT_HASH_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// open-addressing hash map with Robin Hood linear probing
+// - entries are stored in one flat array (no allocation per entry)
+// - probe metadata (distance from home slot + hash fragment) lives in a separate, densely packed array,
+//   so most probes compare 8-byte records instead of keys
+// - same find/emplace/at interface as std::unordered_map, but iterators are invalidated by a rehash
+// - iterators yield a proxy with a read-only key (first) & a mutable value (second) - entries are stored
+//   as std::pair<TKey, TValue>, so Robin Hood displacement can swap them without copying keys
+template <typename TKey, typename TValue, typename THash = std::hash<TKey>, typename TKeyEqual = std::equal_to<TKey>>
+class FlatHashMap
+{
+public:
+    using key_type = TKey;
+    using mapped_type = TValue;
+    using value_type = std::pair<const TKey, TValue>;
+    using size_type = std::size_t;
+
+    template <bool IsConst>
+    struct EntryRef
+    {
+        const TKey& first;
+        std::conditional_t<IsConst, const TValue&, TValue&> second;
+    };
+
+private:
+    using stored_type = std::pair<TKey, TValue>;
+
+    struct Meta
+    {
+        std::uint32_t distance; // distance from home slot + 1, 0 - empty slot
+        std::uint32_t hash;
+    };
+
+    union Slot
+    {
+        Slot() noexcept
+        {
+        }
+
+        ~Slot()
+        {
+        }
+
+        stored_type entry;
+    };
+
+    static constexpr size_type min_capacity = 16;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    std::unique_ptr<Meta[]> meta_;
+    std::unique_ptr<Slot[]> slots_;
+    size_type capacity_ = 0; // power of 2
+    size_type size_ = 0;
+    THash hash_;
+    TKeyEqual key_equal_;
+
+    template <bool IsConst>
+    class Iterator
+    {
+        using Map = std::conditional_t<IsConst, const FlatHashMap, FlatHashMap>;
+
+        Map* map_;
+        size_type index_;
+
+        void skip_empty() noexcept
+        {
+            while (index_ < map_->capacity_ && map_->meta_[index_].distance == 0)
+                ++index_;
+        }
+
+        friend class FlatHashMap;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = EntryRef<IsConst>;
+
+        struct pointer
+        {
+            reference entry;
+
+            const reference* operator->() const noexcept
+            {
+                return &entry;
+            }
+        };
+
+        Iterator(Map* map, size_type index) noexcept
+            : map_{map}
+            , index_{index}
+        {
+            skip_empty();
+        }
+
+        template <bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+        Iterator(const Iterator<OtherIsConst>& other) noexcept
+            : map_{other.map_}
+            , index_{other.index_}
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            auto& entry = map_->slots_[index_].entry;
+            return reference{entry.first, entry.second};
+        }
+
+        pointer operator->() const noexcept
+        {
+            return pointer{**this};
+        }
+
+        Iterator& operator++() noexcept
+        {
+            ++index_;
+            skip_empty();
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            Iterator prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        bool operator==(const Iterator& other) const noexcept
+        {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const Iterator& other) const noexcept
+        {
+            return index_ != other.index_;
+        }
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() = default;
+
+    explicit FlatHashMap(size_type bucket_count)
+    {
+        reserve(bucket_count);
+    }
+
+    FlatHashMap(const FlatHashMap& other)
+        : hash_{other.hash_}
+        , key_equal_{other.key_equal_}
+    {
+        if (other.capacity_ == 0)
+            return;
+
+        allocate(other.capacity_);
+        for (size_type i = 0; i < capacity_; ++i)
+        {
+            if (other.meta_[i].distance != 0)
+            {
+                ::new (&slots_[i].entry) stored_type(other.slots_[i].entry);
+                meta_[i] = other.meta_[i];
+                ++size_;
+            }
+        }
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept
+        : meta_{std::move(other.meta_)}
+        , slots_{std::move(other.slots_)}
+        , capacity_{std::exchange(other.capacity_, 0)}
+        , size_{std::exchange(other.size_, 0)}
+        , hash_{std::move(other.hash_)}
+        , key_equal_{std::move(other.key_equal_)}
+    {
+    }
+
+    FlatHashMap& operator=(const FlatHashMap& other)
+    {
+        if (this != &other)
+            *this = FlatHashMap(other);
+        return *this;
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            meta_ = std::move(other.meta_);
+            slots_ = std::move(other.slots_);
+            capacity_ = std::exchange(other.capacity_, 0);
+            size_ = std::exchange(other.size_, 0);
+            hash_ = std::move(other.hash_);
+            key_equal_ = std::move(other.key_equal_);
+        }
+        return *this;
+    }
+
+    ~FlatHashMap()
+    {
+        clear();
+    }
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_type bucket_count() const noexcept
+    {
+        return capacity_;
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator{this, 0};
+    }
+
+    iterator end() noexcept
+    {
+        return iterator{this, capacity_};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator{this, 0};
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator{this, capacity_};
+    }
+
+    template <typename TK>
+    iterator find(const TK& key)
+    {
+        return iterator{this, find_index(key)};
+    }
+
+    template <typename TK>
+    const_iterator find(const TK& key) const
+    {
+        return const_iterator{this, find_index(key)};
+    }
+
+    TValue& at(const TKey& key)
+    {
+        if (auto index = find_index(key); index != capacity_)
+            return slots_[index].entry.second;
+        throw std::out_of_range{"FlatHashMap::at - key not found"};
+    }
+
+    const TValue& at(const TKey& key) const
+    {
+        if (auto index = find_index(key); index != capacity_)
+            return slots_[index].entry.second;
+        throw std::out_of_range{"FlatHashMap::at - key not found"};
+    }
+
+    template <typename TK, typename... TArgs>
+    std::pair<iterator, bool> emplace(TK&& key, TArgs&&... args)
+    {
+        const auto hash = hash_(key);
+
+        if (auto index = find_index(key, hash); index != capacity_)
+            return {iterator{this, index}, false};
+
+        if ((size_ + 1) * 8 > capacity_ * 7) // max. load factor 7/8
+            reserve(size_ + 1);
+
+        auto index = insert_unique(stored_type(std::piecewise_construct, std::forward_as_tuple(std::forward<TK>(key)), std::forward_as_tuple(std::forward<TArgs>(args)...)),
+            static_cast<std::uint32_t>(hash));
+
+        return {iterator{this, index}, true};
+    }
+
+    void reserve(size_type count)
+    {
+        size_type new_capacity = min_capacity;
+        while (new_capacity * 7 < count * 8)
+            new_capacity *= 2;
+
+        if (new_capacity > capacity_)
+            rehash(new_capacity);
+    }
+
+    void clear() noexcept
+    {
+        for (size_type i = 0; i < capacity_; ++i)
+        {
+            if (meta_[i].distance != 0)
+            {
+                slots_[i].entry.~stored_type();
+                meta_[i].distance = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+private:
+    void allocate(size_type capacity)
+    {
+        meta_ = std::make_unique<Meta[]>(capacity); // value-initialized - all empty
+        slots_.reset(new Slot[capacity]);
+        capacity_ = capacity;
+        size_ = 0;
+    }
+
+    void rehash(size_type new_capacity)
+    {
+        // allocate first - if it throws, the map is left untouched
+        auto new_meta = std::make_unique<Meta[]>(new_capacity);
+        std::unique_ptr<Slot[]> new_slots{new Slot[new_capacity]};
+
+        auto old_meta = std::exchange(meta_, std::move(new_meta));
+        auto old_slots = std::exchange(slots_, std::move(new_slots));
+        const auto old_capacity = std::exchange(capacity_, new_capacity);
+        size_ = 0;
+
+        size_type i = 0;
+        try
+        {
+            for (; i < old_capacity; ++i)
+            {
+                if (old_meta[i].distance != 0)
+                {
+                    insert_unique(std::move(old_slots[i].entry), old_meta[i].hash);
+                    old_slots[i].entry.~stored_type();
+                }
+            }
+        }
+        catch (...)
+        {
+            // throwing move - entries not moved yet are lost, but none of them leaks
+            for (; i < old_capacity; ++i)
+                if (old_meta[i].distance != 0)
+                    old_slots[i].entry.~stored_type();
+            throw;
+        }
+    }
+
+    template <typename TK>
+    size_type find_index(const TK& key) const
+    {
+        return find_index(key, hash_(key));
+    }
+
+    // returns capacity_ when key is not found
+    template <typename TK>
+    size_type find_index(const TK& key, std::size_t full_hash) const
+    {
+        if (size_ == 0)
+            return capacity_;
+
+        const auto hash = static_cast<std::uint32_t>(full_hash);
+        const auto mask = capacity_ - 1;
+
+        for (size_type index = hash & mask, distance = 1;; index = (index + 1) & mask, ++distance)
+        {
+            const Meta meta = meta_[index];
+
+            // Robin Hood invariant - key would have displaced an entry closer to its home slot
+            if (meta.distance < distance)
+                return capacity_;
+
+            if (meta.hash == hash && key_equal_(slots_[index].entry.first, key))
+                return index;
+        }
+    }
+
+    // key must not be in the map & there must be a free slot; returns the index of the inserted entry
+    size_type insert_unique(stored_type&& entry, std::uint32_t hash)
+    {
+        const auto mask = capacity_ - 1;
+        Meta meta{1, hash};
+        size_type inserted_at = npos;
+
+        for (size_type index = hash & mask;; index = (index + 1) & mask, ++meta.distance)
+        {
+            if (meta_[index].distance == 0)
+            {
+                ::new (&slots_[index].entry) stored_type(std::move(entry));
+                meta_[index] = meta;
+                ++size_;
+                return inserted_at == npos ? index : inserted_at;
+            }
+
+            // take the slot from a richer entry (closer to its home) & continue with the displaced one
+            if (meta_[index].distance < meta.distance)
+            {
+                std::swap(entry, slots_[index].entry);
+                std::swap(meta, meta_[index]);
+                if (inserted_at == npos)
+                    inserted_at = index;
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,444 @@
+#ifndef INPLACE_ANY_HPP
+#define INPLACE_ANY_HPP
+
+#include <any>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI)
+#define INPLACE_ANY_HAS_RTTI 1
+#include <typeinfo>
+#endif
+
+// INPLACE_ANY_CROSS_LIBRARY - opt-in: a cast also recognizes values stored by another image (see below); requires RTTI
+#if defined(INPLACE_ANY_CROSS_LIBRARY) && !defined(INPLACE_ANY_HAS_RTTI)
+#error "INPLACE_ANY_CROSS_LIBRARY requires RTTI"
+#endif
+
+namespace Detail
+{
+    // type-erased storage - values that fit the buffer (and are nothrow movable) are stored inline,
+    // larger ones go to the heap like in std::any
+    // - the stored type is identified by the address of its static vtable (one per type) - a cast is
+    //   a single pointer comparison & works without RTTI
+    // - a value stored by another image (DLL, library built with -fvisibility=hidden, plugin loaded with
+    //   RTLD_LOCAL) has its own copy of the vtable & is not recognized - unless INPLACE_ANY_CROSS_LIBRARY
+    //   is defined, then type_info is compared when the pointers differ
+    template <std::size_t Capacity, std::size_t Alignment>
+    class InplaceAnyStorage
+    {
+        static_assert(Capacity >= sizeof(void*), "inline buffer must hold at least a pointer");
+        static_assert(Alignment >= alignof(void*) && (Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+
+        union Buffer
+        {
+            alignas(Alignment) unsigned char bytes[Capacity];
+            void* ptr;
+        };
+
+        struct VTable
+        {
+            void (*destroy)(Buffer& buffer) noexcept;
+            void (*copy)(const Buffer& source, Buffer& target);
+            void (*move)(Buffer& source, Buffer& target) noexcept;
+#ifdef INPLACE_ANY_HAS_RTTI
+            const std::type_info& (*type)() noexcept;
+#endif
+        };
+
+        template <typename T>
+        struct InlineHandler
+        {
+            static T* get(Buffer& buffer) noexcept
+            {
+                return std::launder(reinterpret_cast<T*>(buffer.bytes));
+            }
+
+            static const T* get(const Buffer& buffer) noexcept
+            {
+                return std::launder(reinterpret_cast<const T*>(buffer.bytes));
+            }
+
+            template <typename... TArgs>
+            static T& create(Buffer& buffer, TArgs&&... args)
+            {
+                return *::new (static_cast<void*>(buffer.bytes)) T(std::forward<TArgs>(args)...);
+            }
+
+            static void destroy(Buffer& buffer) noexcept
+            {
+                get(buffer)->~T();
+            }
+
+            static void copy(const Buffer& source, Buffer& target)
+            {
+                create(target, *get(source));
+            }
+
+            static void move(Buffer& source, Buffer& target) noexcept
+            {
+                create(target, std::move(*get(source)));
+                destroy(source);
+            }
+        };
+
+        template <typename T>
+        struct HeapHandler
+        {
+            static T* get(Buffer& buffer) noexcept
+            {
+                return static_cast<T*>(buffer.ptr);
+            }
+
+            static const T* get(const Buffer& buffer) noexcept
+            {
+                return static_cast<const T*>(buffer.ptr);
+            }
+
+            template <typename... TArgs>
+            static T& create(Buffer& buffer, TArgs&&... args)
+            {
+                T* ptr = new T(std::forward<TArgs>(args)...);
+                buffer.ptr = ptr;
+                return *ptr;
+            }
+
+            static void destroy(Buffer& buffer) noexcept
+            {
+                delete get(buffer);
+            }
+
+            static void copy(const Buffer& source, Buffer& target)
+            {
+                create(target, *get(source));
+            }
+
+            static void move(Buffer& source, Buffer& target) noexcept
+            {
+                target.ptr = source.ptr;
+            }
+        };
+
+    public:
+        template <typename T>
+        static constexpr bool is_stored_inline = sizeof(T) <= Capacity && Alignment % alignof(T) == 0 && std::is_nothrow_move_constructible_v<T>;
+
+        template <typename T>
+        using Handler = std::conditional_t<is_stored_inline<T>, InlineHandler<T>, HeapHandler<T>>;
+
+    private:
+#ifdef INPLACE_ANY_HAS_RTTI
+        template <typename T>
+        static const std::type_info& type_of() noexcept
+        {
+            return typeid(T);
+        }
+#endif
+
+        template <typename T>
+        static constexpr auto copy_of()
+        {
+            if constexpr (std::is_copy_constructible_v<T>)
+                return &Handler<T>::copy;
+            else
+                return static_cast<void (*)(const Buffer&, Buffer&)>(nullptr);
+        }
+
+#ifdef INPLACE_ANY_HAS_RTTI
+        template <typename T>
+        static constexpr VTable vtable_for{&Handler<T>::destroy, copy_of<T>(), &Handler<T>::move, &type_of<T>};
+#else
+        template <typename T>
+        static constexpr VTable vtable_for{&Handler<T>::destroy, copy_of<T>(), &Handler<T>::move};
+#endif
+
+        const VTable* vtable_ = nullptr;
+        Buffer buffer_;
+
+    public:
+        InplaceAnyStorage() noexcept = default;
+
+        InplaceAnyStorage(const InplaceAnyStorage& other)
+        {
+            if (other.vtable_)
+            {
+                other.vtable_->copy(other.buffer_, buffer_);
+                vtable_ = other.vtable_;
+            }
+        }
+
+        InplaceAnyStorage(InplaceAnyStorage&& other) noexcept
+        {
+            if (other.vtable_)
+            {
+                other.vtable_->move(other.buffer_, buffer_);
+                vtable_ = std::exchange(other.vtable_, nullptr);
+            }
+        }
+
+        InplaceAnyStorage& operator=(const InplaceAnyStorage& other)
+        {
+            if (this != &other)
+                *this = InplaceAnyStorage(other);
+            return *this;
+        }
+
+        InplaceAnyStorage& operator=(InplaceAnyStorage&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                if (other.vtable_)
+                {
+                    other.vtable_->move(other.buffer_, buffer_);
+                    vtable_ = std::exchange(other.vtable_, nullptr);
+                }
+            }
+            return *this;
+        }
+
+        ~InplaceAnyStorage()
+        {
+            reset();
+        }
+
+        template <typename T, typename... TArgs>
+        T& emplace(TArgs&&... args)
+        {
+            reset();
+            T& value = Handler<T>::create(buffer_, std::forward<TArgs>(args)...);
+            vtable_ = &vtable_for<T>;
+            return value;
+        }
+
+        void reset() noexcept
+        {
+            if (vtable_)
+            {
+                vtable_->destroy(buffer_);
+                vtable_ = nullptr;
+            }
+        }
+
+        bool has_value() const noexcept
+        {
+            return vtable_ != nullptr;
+        }
+
+#ifdef INPLACE_ANY_HAS_RTTI
+        const std::type_info& type() const noexcept
+        {
+            return vtable_ ? vtable_->type() : typeid(void);
+        }
+#endif
+
+        template <typename T>
+        bool holds() const noexcept
+        {
+            if (vtable_ == &vtable_for<T>)
+                return true;
+
+#ifdef INPLACE_ANY_CROSS_LIBRARY
+            return vtable_ && vtable_->type() == typeid(T); // slow path - vtable from another image
+#else
+            return false;
+#endif
+        }
+
+        template <typename T>
+        T* get() noexcept
+        {
+            return Handler<T>::get(buffer_);
+        }
+
+        template <typename T>
+        const T* get() const noexcept
+        {
+            return Handler<T>::get(buffer_);
+        }
+    };
+
+    template <typename T>
+    struct IsInPlaceType : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct IsInPlaceType<std::in_place_type_t<T>> : std::true_type
+    {
+    };
+
+    template <bool MoveOnly>
+    struct CopyControl
+    {
+    };
+
+    template <>
+    struct CopyControl<true>
+    {
+        CopyControl() = default;
+        CopyControl(const CopyControl&) = delete;
+        CopyControl& operator=(const CopyControl&) = delete;
+        CopyControl(CopyControl&&) = default;
+        CopyControl& operator=(CopyControl&&) = default;
+    };
+} // namespace Detail
+
+// std::any with a configurable small-object buffer
+// - values up to Capacity bytes (with alignment up to Alignment) are stored without allocation
+// - MoveOnly variant accepts move-only types and cannot be copied itself
+// - a successful any_cast compares one pointer (no type_info) - usable with -fno-rtti (type() requires RTTI)
+// - a value is recognized only by the image (executable or shared library) that stored it - casts across
+//   shared library boundaries fail unless INPLACE_ANY_CROSS_LIBRARY is defined (requires RTTI)
+template <std::size_t Capacity = 4 * sizeof(void*), std::size_t Alignment = alignof(std::max_align_t), bool MoveOnly = false>
+class inplace_any : private Detail::CopyControl<MoveOnly>
+{
+    using Storage = Detail::InplaceAnyStorage<Capacity, Alignment>;
+
+    Storage storage_;
+
+    template <typename T, std::size_t C, std::size_t A, bool M>
+    friend const T* any_cast(const inplace_any<C, A, M>* operand) noexcept;
+
+    template <typename T, std::size_t C, std::size_t A, bool M>
+    friend T* any_cast(inplace_any<C, A, M>* operand) noexcept;
+
+    template <typename T>
+    static constexpr bool is_storable = MoveOnly ? std::is_move_constructible_v<T> : std::is_copy_constructible_v<T>;
+
+public:
+    static constexpr std::size_t capacity = Capacity;
+    static constexpr std::size_t alignment = Alignment;
+
+    template <typename T>
+    static constexpr bool is_stored_inline = Storage::template is_stored_inline<std::decay_t<T>>;
+
+    inplace_any() noexcept = default;
+
+    template <typename T, typename TValue = std::decay_t<T>,
+        typename = std::enable_if_t<!std::is_same_v<TValue, inplace_any> && !Detail::IsInPlaceType<TValue>::value && is_storable<TValue>>>
+    inplace_any(T&& value)
+    {
+        storage_.template emplace<TValue>(std::forward<T>(value));
+    }
+
+    template <typename T, typename... TArgs, typename TValue = std::decay_t<T>,
+        typename = std::enable_if_t<is_storable<TValue> && std::is_constructible_v<TValue, TArgs...>>>
+    explicit inplace_any(std::in_place_type_t<T>, TArgs&&... args)
+    {
+        storage_.template emplace<TValue>(std::forward<TArgs>(args)...);
+    }
+
+    template <typename T, typename TValue = std::decay_t<T>,
+        typename = std::enable_if_t<!std::is_same_v<TValue, inplace_any> && is_storable<TValue>>>
+    inplace_any& operator=(T&& value)
+    {
+        *this = inplace_any(std::forward<T>(value));
+        return *this;
+    }
+
+    template <typename T, typename... TArgs, typename TValue = std::decay_t<T>,
+        typename = std::enable_if_t<is_storable<TValue> && std::is_constructible_v<TValue, TArgs...>>>
+    TValue& emplace(TArgs&&... args)
+    {
+        return storage_.template emplace<TValue>(std::forward<TArgs>(args)...);
+    }
+
+    void reset() noexcept
+    {
+        storage_.reset();
+    }
+
+    void swap(inplace_any& other) noexcept
+    {
+        std::swap(storage_, other.storage_);
+    }
+
+    bool has_value() const noexcept
+    {
+        return storage_.has_value();
+    }
+
+#ifdef INPLACE_ANY_HAS_RTTI
+    const std::type_info& type() const noexcept
+    {
+        return storage_.type();
+    }
+#endif
+
+    // true if T is the type of the stored value - no RTTI needed
+    template <typename T>
+    bool holds() const noexcept
+    {
+        return storage_.template holds<std::remove_cv_t<T>>();
+    }
+};
+
+template <std::size_t Capacity = 4 * sizeof(void*), std::size_t Alignment = alignof(std::max_align_t)>
+using move_only_inplace_any = inplace_any<Capacity, Alignment, true>;
+
+template <std::size_t Capacity, std::size_t Alignment, bool MoveOnly>
+void swap(inplace_any<Capacity, Alignment, MoveOnly>& a, inplace_any<Capacity, Alignment, MoveOnly>& b) noexcept
+{
+    a.swap(b);
+}
+
+////////////////////////////////////////////////////////////
+// any_cast - same semantics as std::any_cast (throws std::bad_any_cast)
+
+template <typename T, std::size_t C, std::size_t A, bool M>
+const T* any_cast(const inplace_any<C, A, M>* operand) noexcept
+{
+    using TValue = std::remove_cv_t<T>;
+
+    if (operand && operand->storage_.template holds<TValue>())
+        return operand->storage_.template get<TValue>();
+    return nullptr;
+}
+
+template <typename T, std::size_t C, std::size_t A, bool M>
+T* any_cast(inplace_any<C, A, M>* operand) noexcept
+{
+    using TValue = std::remove_cv_t<T>;
+
+    if (operand && operand->storage_.template holds<TValue>())
+        return operand->storage_.template get<TValue>();
+    return nullptr;
+}
+
+template <typename T, std::size_t C, std::size_t A, bool M>
+T any_cast(const inplace_any<C, A, M>& operand)
+{
+    using TValue = std::remove_cv_t<std::remove_reference_t<T>>;
+    static_assert(std::is_constructible_v<T, const TValue&>, "invalid cast");
+
+    if (auto* ptr = any_cast<TValue>(&operand))
+        return static_cast<T>(*ptr);
+    throw std::bad_any_cast{};
+}
+
+template <typename T, std::size_t C, std::size_t A, bool M>
+T any_cast(inplace_any<C, A, M>& operand)
+{
+    using TValue = std::remove_cv_t<std::remove_reference_t<T>>;
+    static_assert(std::is_constructible_v<T, TValue&>, "invalid cast");
+
+    if (auto* ptr = any_cast<TValue>(&operand))
+        return static_cast<T>(*ptr);
+    throw std::bad_any_cast{};
+}
+
+template <typename T, std::size_t C, std::size_t A, bool M>
+T any_cast(inplace_any<C, A, M>&& operand)
+{
+    using TValue = std::remove_cv_t<std::remove_reference_t<T>>;
+    static_assert(std::is_constructible_v<T, TValue>, "invalid cast");
+
+    if (auto* ptr = any_cast<TValue>(&operand))
+        return static_cast<T>(std::move(*ptr));
+    throw std::bad_any_cast{};
+}
+
+#endif
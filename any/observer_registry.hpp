@@ -0,0 +1,53 @@
+#ifndef OBSERVER_REGISTRY_HPP
+#define OBSERVER_REGISTRY_HPP
+
+#include <algorithm>
+#include <any>
+#include <string>
+#include <vector>
+
+#include "rcu.hpp"
+#include "temp_monitor.hpp"
+
+// Observer list that can be changed while notifications are running
+// - notify() iterates an immutable snapshot of the list without locking
+// - subscribe/unsubscribe publish a new list (copy-on-write)
+// - after unsubscribe() returns the observer is not called any more and can be destroyed
+//   (must not be called from Observer::update)
+class ObserverRegistry
+{
+    RcuPtr<std::vector<Observer*>> observers_;
+
+public:
+    void subscribe(Observer& observer)
+    {
+        observers_.update([&observer](std::vector<Observer*>& observers) { observers.push_back(&observer); });
+    }
+
+    void unsubscribe(Observer& observer)
+    {
+        observers_.update([&observer](std::vector<Observer*>& observers) {
+            observers.erase(std::remove(observers.begin(), observers.end(), &observer), observers.end());
+        });
+    }
+
+    std::size_t size() const
+    {
+        return observers_.read()->size();
+    }
+
+    void notify(const std::any& sender, const std::string& msg) const
+    {
+        const auto observers = observers_.read();
+
+        for (Observer* o : *observers)
+            o->update(sender, msg);
+    }
+
+    void notify(TempMonitor& monitor) const
+    {
+        notify(&monitor, std::to_string(monitor.get_temp()));
+    }
+};
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef RCU_HPP
+#define RCU_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "cache_line.hpp"
+
+// RCU-style (read-copy-update) pointer to an immutable value
+// - readers pin the current grace period and read the value without any lock
+// - writers (serialized) copy the value, modify the copy and publish it atomically;
+//   the old value is deleted after all readers that could see it have finished
+// - reader counters are sharded by thread, so readers do not contend on one cache line
+template <typename T>
+class RcuPtr
+{
+    static constexpr std::size_t no_of_shards = 16;
+
+    struct alignas(cache_line_size) ReaderCounter
+    {
+        std::atomic<std::int64_t> value{0};
+    };
+
+    std::atomic<const T*> ptr_;
+    std::atomic<std::uint64_t> grace_period_{0};
+    mutable ReaderCounter readers_[2][no_of_shards];
+    std::mutex mtx_writers_;
+
+    static std::size_t thread_shard()
+    {
+        static std::atomic<std::size_t> next_shard{0};
+        thread_local const std::size_t shard = next_shard++ % no_of_shards;
+        return shard;
+    }
+
+    // waits until all readers of the current grace period have finished
+    void synchronize()
+    {
+        const auto gp = grace_period_.fetch_add(1);
+
+        for (auto& counter : readers_[gp % 2])
+            while (counter.value.load(std::memory_order_acquire) != 0)
+                std::this_thread::yield();
+    }
+
+public:
+    class ReadGuard
+    {
+        ReaderCounter* counter_;
+        const T* value_;
+
+        friend class RcuPtr;
+
+        ReadGuard(ReaderCounter* counter, const T* value)
+            : counter_{counter}
+            , value_{value}
+        {
+        }
+
+    public:
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        ~ReadGuard()
+        {
+            counter_->value.fetch_sub(1, std::memory_order_release);
+        }
+
+        const T& operator*() const
+        {
+            return *value_;
+        }
+
+        const T* operator->() const
+        {
+            return value_;
+        }
+    };
+
+    explicit RcuPtr(std::unique_ptr<const T> value = std::make_unique<const T>())
+        : ptr_{value.release()}
+    {
+    }
+
+    RcuPtr(const RcuPtr&) = delete;
+    RcuPtr& operator=(const RcuPtr&) = delete;
+
+    ~RcuPtr()
+    {
+        delete ptr_.load();
+    }
+
+    // value is valid as long as the guard lives - must not call update() while holding it
+    ReadGuard read() const
+    {
+        const auto shard = thread_shard();
+
+        while (true)
+        {
+            const auto gp = grace_period_.load();
+            ReaderCounter& counter = readers_[gp % 2][shard];
+            counter.value.fetch_add(1);
+
+            if (grace_period_.load() == gp)
+                return ReadGuard{&counter, ptr_.load()};
+
+            counter.value.fetch_sub(1); // writer started a new grace period in the meantime
+        }
+    }
+
+    // modify(T&) is called on a copy of the current value; returns after the old value is reclaimed
+    template <typename TModify>
+    void update(TModify modify)
+    {
+        std::lock_guard lk{mtx_writers_};
+
+        auto new_value = std::make_unique<T>(*ptr_.load());
+        modify(*new_value);
+
+        const T* old_value = ptr_.exchange(new_value.release());
+        synchronize();
+        delete old_value;
+    }
+};
+
+#endif
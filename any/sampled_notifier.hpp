@@ -0,0 +1,111 @@
+#ifndef SAMPLED_NOTIFIER_HPP
+#define SAMPLED_NOTIFIER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "temp_monitor.hpp"
+
+struct SamplingPolicy
+{
+    double deadband = 0.0;                                      // notify only when the change is larger than deadband
+    std::chrono::steady_clock::duration min_interval{0};        // max. notification rate
+};
+
+// Sampling layer for TempMonitor notifications - each observer has its own policy
+// - readings within the deadband of the value last sent to an observer are skipped
+// - readings arriving faster than the observer's rate are coalesced - only the latest one is kept
+// - a coalesced reading is delivered by tick() as soon as the observer's interval has elapsed,
+//   so an observer never stays with a stale value (flush() delivers it immediately)
+class SampledNotifier
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+private:
+    struct Subscription
+    {
+        Observer* observer;
+        SamplingPolicy policy;
+        std::optional<double> last_sent;
+        clock::time_point last_sent_time;
+        std::optional<double> pending;
+    };
+
+    std::vector<Subscription> subscriptions_;
+    TempMonitor* monitor_;
+
+    void send(Subscription& s, double temp, clock::time_point now)
+    {
+        s.last_sent = temp;
+        s.last_sent_time = now;
+        s.pending.reset();
+        s.observer->update(monitor_, std::to_string(temp));
+    }
+
+public:
+    explicit SampledNotifier(TempMonitor& monitor)
+        : monitor_{&monitor}
+    {
+    }
+
+    void subscribe(Observer& observer, const SamplingPolicy& policy = SamplingPolicy{})
+    {
+        subscriptions_.push_back(Subscription{&observer, policy, std::nullopt, clock::time_point{}, std::nullopt});
+    }
+
+    void unsubscribe(Observer& observer)
+    {
+        subscriptions_.erase(std::remove_if(subscriptions_.begin(), subscriptions_.end(), [&observer](const Subscription& s) { return s.observer == &observer; }),
+            subscriptions_.end());
+    }
+
+    // current reading of the monitor
+    void notify(clock::time_point now = clock::now())
+    {
+        const double temp = monitor_->get_temp();
+
+        for (auto& s : subscriptions_)
+        {
+            if (s.last_sent && std::abs(temp - *s.last_sent) <= s.policy.deadband)
+            {
+                s.pending.reset(); // observer already has a value close enough
+                continue;
+            }
+
+            if (s.last_sent && now - s.last_sent_time < s.policy.min_interval)
+            {
+                s.pending = temp;
+                continue;
+            }
+
+            send(s, temp, now);
+        }
+    }
+
+    // delivers coalesced readings of observers whose interval has elapsed - call periodically
+    void tick(clock::time_point now = clock::now())
+    {
+        for (auto& s : subscriptions_)
+        {
+            if (s.pending && now - s.last_sent_time >= s.policy.min_interval)
+                send(s, *s.pending, now);
+        }
+    }
+
+    // delivers all coalesced readings regardless of the rate limits
+    void flush(clock::time_point now = clock::now())
+    {
+        for (auto& s : subscriptions_)
+        {
+            if (s.pending)
+                send(s, *s.pending, now);
+        }
+    }
+};
+
+#endif
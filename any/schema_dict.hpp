@@ -0,0 +1,320 @@
+#ifndef SCHEMA_DICT_HPP
+#define SCHEMA_DICT_HPP
+
+#include <any>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "dynamic_dict.hpp"
+
+namespace Detail
+{
+    constexpr std::uint64_t fnv1a(std::string_view text) noexcept
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (const char c : text)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    constexpr std::uint64_t mix_hash(std::uint64_t hash, std::uint64_t seed) noexcept
+    {
+        hash ^= seed * 0x9E3779B97F4A7C15ull;
+        hash *= 0xBF58476D1CE4E5B9ull;
+        return hash ^ (hash >> 31);
+    }
+
+    constexpr std::size_t schema_capacity(std::size_t no_of_keys) noexcept
+    {
+        std::size_t capacity = 1;
+        while (capacity < no_of_keys)
+            capacity *= 2;
+        return capacity;
+    }
+}
+
+// key with a hash computed at compile time (for constant keys)
+class StaticKey
+{
+    std::string_view name_;
+    std::uint64_t hash_;
+
+public:
+    constexpr explicit StaticKey(std::string_view name) noexcept
+        : name_{name}
+        , hash_{Detail::fnv1a(name)}
+    {
+    }
+
+    constexpr std::string_view name() const noexcept
+    {
+        return name_;
+    }
+
+    constexpr std::uint64_t hash() const noexcept
+    {
+        return hash_;
+    }
+};
+
+namespace KeyLiterals
+{
+    constexpr StaticKey operator""_key(const char* text, std::size_t length) noexcept
+    {
+        return StaticKey{std::string_view{text, length}};
+    }
+}
+
+// set of keys known up front with a perfect hash built at compile time (hash & displace)
+// - keys are grouped in buckets by their hash, every bucket gets a displacement (or a direct slot)
+//   that puts all its keys into distinct, otherwise unused slots
+// - find() - two array reads & a key comparison, index() - for constant keys evaluated at compile time
+template <std::size_t N>
+class KeySchema
+{
+    static_assert(N > 0, "schema must have at least one key");
+
+    static constexpr std::size_t capacity = Detail::schema_capacity(N);
+    static constexpr std::size_t mask = capacity - 1;
+    static constexpr std::uint64_t max_displacement = 1'000'000;
+
+    std::array<std::string_view, N> names_;
+    std::array<std::uint64_t, N> hashes_{};
+    std::array<std::int64_t, capacity> displacements_{}; // < 0 - direct slot: -(slot + 1)
+    std::array<std::size_t, capacity> slots_{};          // key index, N - empty slot
+
+    static constexpr std::size_t bucket_of(std::uint64_t hash) noexcept
+    {
+        return Detail::mix_hash(hash, 0) & mask;
+    }
+
+    constexpr void build()
+    {
+        std::array<std::size_t, N> bucket_of_key{};
+        std::array<std::size_t, capacity> bucket_sizes{};
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            hashes_[i] = Detail::fnv1a(names_[i]);
+
+            for (std::size_t j = 0; j < i; ++j)
+                if (names_[j] == names_[i])
+                    throw std::logic_error{"duplicate key in schema"};
+
+            bucket_of_key[i] = bucket_of(hashes_[i]);
+            ++bucket_sizes[bucket_of_key[i]];
+        }
+
+        for (auto& slot : slots_)
+            slot = N;
+
+        // largest buckets first - they are the hardest to place
+        for (std::size_t size = N; size > 1; --size)
+        {
+            for (std::size_t bucket = 0; bucket < capacity; ++bucket)
+            {
+                if (bucket_sizes[bucket] != size)
+                    continue;
+
+                std::array<std::size_t, N> keys{};
+                std::size_t no_of_keys = 0;
+                for (std::size_t i = 0; i < N; ++i)
+                    if (bucket_of_key[i] == bucket)
+                        keys[no_of_keys++] = i;
+
+                std::uint64_t displacement = 1;
+                for (;; ++displacement)
+                {
+                    if (displacement > max_displacement)
+                        throw std::logic_error{"cannot build perfect hash for schema"};
+
+                    bool fits = true;
+                    for (std::size_t k = 0; k < no_of_keys && fits; ++k)
+                    {
+                        const auto slot = Detail::mix_hash(hashes_[keys[k]], displacement) & mask;
+                        fits = slots_[slot] == N;
+                        for (std::size_t other = 0; other < k && fits; ++other)
+                            fits = slot != (Detail::mix_hash(hashes_[keys[other]], displacement) & mask);
+                    }
+
+                    if (fits)
+                        break;
+                }
+
+                for (std::size_t k = 0; k < no_of_keys; ++k)
+                    slots_[Detail::mix_hash(hashes_[keys[k]], displacement) & mask] = keys[k];
+                displacements_[bucket] = static_cast<std::int64_t>(displacement);
+            }
+        }
+
+        // single keys go straight into free slots
+        std::size_t free_slot = 0;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (bucket_sizes[bucket_of_key[i]] != 1)
+                continue;
+
+            while (slots_[free_slot] != N)
+                ++free_slot;
+
+            slots_[free_slot] = i;
+            displacements_[bucket_of_key[i]] = -static_cast<std::int64_t>(free_slot + 1);
+        }
+    }
+
+public:
+    static constexpr std::size_t no_of_keys = N;
+    static constexpr std::size_t npos = N;
+
+    template <typename... TKeys, typename = std::enable_if_t<sizeof...(TKeys) == N && (std::is_convertible_v<TKeys, std::string_view> && ...)>>
+    constexpr explicit KeySchema(TKeys... keys)
+        : names_{std::string_view{keys}...}
+    {
+        build();
+    }
+
+    // index of the key or npos
+    constexpr std::size_t find(const StaticKey& key) const noexcept
+    {
+        const auto displacement = displacements_[bucket_of(key.hash())];
+        const auto slot = displacement < 0 ? static_cast<std::size_t>(-displacement - 1)
+                                           : Detail::mix_hash(key.hash(), static_cast<std::uint64_t>(displacement)) & mask;
+        const auto index = slots_[slot];
+
+        return index != N && hashes_[index] == key.hash() && names_[index] == key.name() ? index : npos;
+    }
+
+    // for keys that must be in the schema - fails to compile in a constant expression otherwise
+    constexpr std::size_t index(const StaticKey& key) const
+    {
+        const auto index = find(key);
+        if (index == npos)
+            throw std::out_of_range{"key is not in schema"};
+        return index;
+    }
+
+    constexpr std::string_view key(std::size_t index) const
+    {
+        return names_[index];
+    }
+};
+
+template <typename... TKeys>
+KeySchema(TKeys...) -> KeySchema<sizeof...(TKeys)>;
+
+// index of a key in Schema - typed by the schema object, so a slot of one schema cannot be used with another
+// (even with the same number of keys); created only by slot_of(), so the index is always in range
+template <const auto& Schema>
+class SchemaSlot
+{
+    std::size_t index_;
+
+    constexpr explicit SchemaSlot(std::size_t index) noexcept
+        : index_{index}
+    {
+    }
+
+    template <const auto& S>
+    friend constexpr SchemaSlot<S> slot_of(const StaticKey& key);
+
+public:
+    constexpr std::size_t index() const noexcept
+    {
+        return index_;
+    }
+};
+
+// for keys that must be in Schema - fails to compile in a constant expression otherwise
+template <const auto& Schema>
+constexpr SchemaSlot<Schema> slot_of(const StaticKey& key)
+{
+    return SchemaSlot<Schema>{Schema.index(key)};
+}
+
+// DynamicDict with a fixed array of values for the keys of Schema (constexpr KeySchema with static storage)
+// - get<T>(SchemaSlot<Schema>) - one array index, get<T>(StaticKey) - perfect hash (folded for constant keys)
+// - keys that are not in the schema are stored in a BasicDynamicDict
+template <const auto& Schema, typename TAny = std::any>
+class SchemaDict
+{
+    using KeySchemaType = std::remove_cv_t<std::remove_reference_t<decltype(Schema)>>;
+
+    std::array<TAny, KeySchemaType::no_of_keys> values_;
+    BasicDynamicDict<TAny> dynamic_dict_;
+
+    template <typename T>
+    T get_at(std::size_t index)
+    {
+        using std::any_cast;
+
+        auto& value = values_[index];
+        if (!value.has_value())
+            throw std::out_of_range{"SchemaDict::get - no value for key"};
+
+        return any_cast<T>(value);
+    }
+
+public:
+    bool insert(const StaticKey& key, TAny value)
+    {
+        if (const auto index = Schema.find(key); index != KeySchemaType::npos)
+        {
+            if (values_[index].has_value())
+                return false;
+
+            values_[index] = std::move(value);
+            return true;
+        }
+
+        return dynamic_dict_.insert(key.name(), std::move(value)).second;
+    }
+
+    bool insert(std::string_view key, TAny value)
+    {
+        return insert(StaticKey{key}, std::move(value));
+    }
+
+    bool contains(const StaticKey& key) const
+    {
+        if (const auto index = Schema.find(key); index != KeySchemaType::npos)
+            return values_[index].has_value();
+
+        return dynamic_dict_.contains(key.name());
+    }
+
+    bool contains(std::string_view key) const
+    {
+        return contains(StaticKey{key});
+    }
+
+    template <typename T>
+    T get(SchemaSlot<Schema> slot)
+    {
+        return get_at<T>(slot.index());
+    }
+
+    template <typename T>
+    T get(const StaticKey& key)
+    {
+        if (const auto index = Schema.find(key); index != KeySchemaType::npos)
+            return get_at<T>(index);
+
+        return dynamic_dict_.template get<T>(key.name());
+    }
+
+    template <typename T>
+    T get(std::string_view key)
+    {
+        return get<T>(StaticKey{key});
+    }
+};
+
+#endif
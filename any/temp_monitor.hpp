@@ -0,0 +1,76 @@
+#ifndef TEMP_MONITOR_HPP
+#define TEMP_MONITOR_HPP
+
+#include <algorithm>
+#include <any>
+#include <string>
+#include <vector>
+
+#include "event_bus.hpp"
+
+////////////////////////////////////
+// wide interfaces
+
+class Observer
+{
+public:
+    virtual void update(std::any sender, const std::string& msg) = 0;
+    virtual ~Observer() = default;
+};
+
+struct TemperatureSample
+{
+    double value;
+};
+
+class TempMonitor
+{
+    std::vector<Observer*> observes_;
+    double temp_ = 23.88;
+public:
+    void subscribe(Observer* o)
+    {
+        observes_.push_back(o);
+    }
+
+    void unsubscribe(Observer* o)
+    {
+        observes_.erase(std::remove(observes_.begin(), observes_.end(), o), observes_.end());
+    }
+
+    void notify()
+    {
+        for(const auto& o : observes_)
+            o->update(this, std::to_string(get_temp()));
+    }
+
+    // typed notification - see EventBus
+    void notify(EventBus& bus)
+    {
+        bus.publish(TemperatureSample{get_temp()});
+    }
+
+    double get_temp() const
+    {
+        return temp_;
+    }
+
+    // new reading from the sensor
+    void set_temp(double temp)
+    {
+        temp_ = temp;
+    }
+};
+
+class Logger : public Observer
+{
+public:
+    void update(std::any sender, [[maybe_unused]] const std::string& msg) override
+    {
+        TempMonitor* const* monitor = std::any_cast<TempMonitor*>(&sender);
+        if (monitor)
+            (*monitor)->get_temp();
+    }
+};
+
+#endif
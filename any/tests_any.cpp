@@ -5,7 +5,9 @@
 #include <numeric>
 #include <string>
 #include <vector>
-#include <unordered_map>
+
+#include "dynamic_dict.hpp"
+#include "temp_monitor.hpp"
 
 using namespace std;
 
@@ -36,61 +38,10 @@ TEST_CASE("any")
 }
 
 ////////////////////////////////////
-// wide interfaces
-
-class Observer
-{
-public:
-    virtual void update(std::any sender, const string& msg) = 0;
-    virtual ~Observer() = default;
-};
-
-class TempMonitor
-{
-    std::vector<Observer*> observes_;
-public:
-    void notify()
-    {
-        for(const auto& o : observes_)
-            o->update(this, std::to_string(get_temp()));
-    }
-    double get_temp() const
-    {
-        return 23.88;
-    }
-};
-
-class Logger : public Observer
-{
-public:
-    void update(std::any sender, const string& msg) override
-    {
-        TempMonitor* const* monitor = std::any_cast<TempMonitor*>(&sender);
-        if (monitor)
-            (*monitor)->get_temp();
-    }
-};
-
-///////////////////////////////////////////////////////////
-
-class DynamicDict
-{
-    std::unordered_map<std::string, std::any> dict_;
-public:
-    auto insert(std::string key, std::any value)
-    {
-        return dict_.emplace(std::move(key), std::move(value));
-    }
-
-    template <typename T>
-    T get(const std::string& key)
-    {
-        return std::any_cast<T>(dict_.at(key));
-    }
-};
+// wide interfaces - see temp_monitor.hpp
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// dynamic dict
+// dynamic dict - see dynamic_dict.hpp
 
 TEST_CASE("dynamic dict")
 {
@@ -0,0 +1,959 @@
+#include <any>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "columnar_dict.hpp"
+#include "concurrent_dynamic_dict.hpp"
+#include "dynamic_dict.hpp"
+#include "flat_hash_map.hpp"
+#include "inplace_any.hpp"
+#include "schema_dict.hpp"
+
+#if __has_include(<sys/mman.h>)
+#include "dict_snapshot.hpp"
+#endif
+
+using namespace std;
+
+TEST_CASE("inplace_any", "[inplace_any]")
+{
+    inplace_any<> anything;
+
+    CHECK(anything.has_value() == false);
+    CHECK(anything.type() == typeid(void));
+
+    anything = 42;
+    anything = 3.14;
+    anything = "text"s;
+    anything = std::vector{1, 3, 4};
+
+    CHECK(anything.type() == typeid(std::vector<int>));
+
+    auto vec = any_cast<std::vector<int>>(anything);
+    CHECK(vec == std::vector{1, 3, 4});
+
+    CHECK_THROWS_AS(any_cast<int>(anything), std::bad_any_cast);
+
+    CHECK(any_cast<int>(&anything) == nullptr);
+    REQUIRE(any_cast<std::vector<int>>(&anything) != nullptr);
+    any_cast<std::vector<int>&>(anything).push_back(5);
+    CHECK(any_cast<const std::vector<int>&>(anything).size() == 4);
+
+    SECTION("small values are stored inline")
+    {
+        static_assert(inplace_any<>::is_stored_inline<std::string>);
+        static_assert(inplace_any<>::is_stored_inline<std::vector<int>>);
+        static_assert(!inplace_any<8>::is_stored_inline<std::string>);
+        static_assert(!inplace_any<64, 8>::is_stored_inline<long double>);
+    }
+
+    SECTION("values larger than the buffer go to the heap")
+    {
+        inplace_any<8> small = "a long text that does not fit any small string buffer"s;
+        inplace_any<8> copy = small;
+
+        CHECK(any_cast<std::string>(copy) == any_cast<std::string>(small));
+
+        inplace_any<8> moved = std::move(small);
+        CHECK(any_cast<std::string>(moved) == "a long text that does not fit any small string buffer");
+        CHECK(small.has_value() == false);
+    }
+
+    SECTION("copy & move")
+    {
+        inplace_any<> copy = anything;
+        CHECK(any_cast<std::vector<int>>(copy) == std::vector{1, 3, 4, 5});
+
+        inplace_any<> moved = std::move(copy);
+        CHECK(any_cast<std::vector<int>>(moved) == std::vector{1, 3, 4, 5});
+        CHECK(copy.has_value() == false);
+
+        moved.reset();
+        CHECK(moved.has_value() == false);
+    }
+
+    SECTION("emplace & in_place_type")
+    {
+        inplace_any<> str{std::in_place_type<std::string>, 3, 'a'};
+        CHECK(any_cast<std::string>(str) == "aaa");
+
+        str.emplace<int>(13);
+        CHECK(any_cast<int>(str) == 13);
+    }
+}
+
+TEST_CASE("inplace_any - types identified by static tokens", "[inplace_any]")
+{
+    struct Celsius
+    {
+        double value;
+    };
+
+    struct Fahrenheit
+    {
+        double value;
+    };
+
+    inplace_any<> temp = Celsius{23.88};
+
+    CHECK(temp.holds<Celsius>());
+    CHECK(temp.holds<const Celsius>());
+    CHECK(temp.holds<Fahrenheit>() == false);
+    CHECK(any_cast<Fahrenheit>(&temp) == nullptr);
+    CHECK(any_cast<const Celsius>(&temp)->value == 23.88);
+
+    inplace_any<> number = 42;
+    CHECK(number.holds<int>());
+    CHECK(number.holds<unsigned int>() == false);
+    CHECK(number.holds<long>() == false);
+
+    inplace_any<> empty;
+    CHECK(empty.holds<int>() == false);
+    CHECK(any_cast<int>(&empty) == nullptr);
+}
+
+TEST_CASE("move_only_inplace_any", "[inplace_any]")
+{
+    static_assert(!std::is_copy_constructible_v<move_only_inplace_any<>>);
+    static_assert(std::is_nothrow_move_constructible_v<move_only_inplace_any<>>);
+
+    move_only_inplace_any<> anything = std::make_unique<int>(42);
+
+    auto moved = std::move(anything);
+    CHECK(*any_cast<std::unique_ptr<int>&>(moved) == 42);
+
+    auto ptr = any_cast<std::unique_ptr<int>>(std::move(moved));
+    CHECK(*ptr == 42);
+}
+
+TEMPLATE_TEST_CASE("dynamic dict", "[dynamic_dict]", BasicDynamicDict<std::any>, BasicDynamicDict<inplace_any<>>, BasicDynamicDict<move_only_inplace_any<>>,
+    (BasicDynamicDict<std::any, FlatHashMap>))
+{
+    TestType dd;
+
+    auto [pos, inserted] = dd.insert("id", 42);
+    CHECK(inserted);
+    CHECK(dd.insert("id", 665).second == false);
+    dd.insert("name", "John"s);
+
+    CHECK(dd.template get<int>("id") == 42);
+    CHECK(dd.template get<std::string>("name") == "John");
+    CHECK_THROWS_AS(dd.template get<double>("id"), std::bad_any_cast);
+    CHECK_THROWS_AS(dd.template get<int>("unknown"), std::out_of_range);
+}
+
+TEST_CASE("flat hash map", "[flat_hash_map]")
+{
+    FlatHashMap<std::string, int> map;
+
+    CHECK(map.empty());
+    CHECK(map.find("one") == map.end());
+
+    auto [pos, inserted] = map.emplace("one", 1);
+    CHECK(inserted);
+    CHECK(pos->first == "one");
+    CHECK(pos->second == 1);
+
+    auto [other_pos, other_inserted] = map.emplace("one", 665);
+    CHECK(other_inserted == false);
+    CHECK(other_pos->second == 1);
+
+    CHECK(map.at("one") == 1);
+    CHECK_THROWS_AS(map.at("two"), std::out_of_range);
+
+    static_assert(!std::is_assignable_v<decltype((pos->first)), std::string>, "keys are read-only");
+    static_assert(!std::is_assignable_v<decltype(((*std::as_const(map).begin()).second)), int>, "const iterator - values are read-only");
+
+    SECTION("failed rehash keeps the map intact")
+    {
+        CHECK_THROWS_AS(map.reserve(std::size_t{1} << 59), std::bad_alloc);
+
+        CHECK(map.size() == 1);
+        CHECK(map.at("one") == 1);
+        map.emplace("two", 2);
+        CHECK(map.at("two") == 2);
+    }
+
+    SECTION("grows & keeps all entries")
+    {
+        constexpr int NO_OF_ITEMS = 10'000;
+
+        for (int i = 0; i < NO_OF_ITEMS; ++i)
+            map.emplace(std::to_string(i), i);
+
+        CHECK(map.size() == NO_OF_ITEMS + 1);
+        CHECK(map.size() * 8 <= map.bucket_count() * 7);
+
+        bool all_found = true;
+        for (int i = 0; i < NO_OF_ITEMS; ++i)
+        {
+            auto pos = map.find(std::to_string(i));
+            all_found = all_found && pos != map.end() && pos->second == i;
+        }
+        CHECK(all_found);
+
+        long sum = 0;
+        for (const auto& [key, value] : map)
+            sum += value;
+        CHECK(sum == 1 + NO_OF_ITEMS * (NO_OF_ITEMS - 1L) / 2);
+
+        FlatHashMap<std::string, int> copy = map;
+        CHECK(copy.size() == map.size());
+        CHECK(copy.at("9999") == 9999);
+
+        FlatHashMap<std::string, int> moved = std::move(copy);
+        CHECK(moved.at("9999") == 9999);
+        CHECK(copy.size() == 0);
+    }
+
+    SECTION("colliding hashes")
+    {
+        struct BadHash
+        {
+            size_t operator()(int) const noexcept
+            {
+                return 7;
+            }
+        };
+
+        FlatHashMap<int, int, BadHash> colliding;
+        for (int i = 0; i < 100; ++i)
+            colliding.emplace(i, i * i);
+
+        CHECK(colliding.size() == 100);
+        CHECK(colliding.at(99) == 99 * 99);
+        CHECK(colliding.find(100) == colliding.end());
+    }
+}
+
+TEST_CASE("dynamic dict - keys", "[dynamic_dict]")
+{
+    DynamicDict dd;
+
+    const std::string long_key = "a key that does not fit the small string buffer";
+    dd.insert(long_key, 42);
+    dd.insert("id"sv, 1);
+
+    SECTION("lookup by std::string, std::string_view and literals does not allocate")
+    {
+        const auto allocations_before = no_of_allocations_in_thread;
+
+        CHECK(dd.get<int>(long_key) == 42);
+        CHECK(dd.get<int>(std::string_view{long_key}) == 42);
+        CHECK(dd.get<int>("a key that does not fit the small string buffer") == 42);
+        CHECK(dd.contains("id"));
+        CHECK(dd.contains("unknown") == false);
+
+        CHECK(no_of_allocations_in_thread - allocations_before == 0);
+    }
+
+    SECTION("inserting an existing key does not allocate")
+    {
+        const auto allocations_before = no_of_allocations_in_thread;
+
+        CHECK(dd.insert(std::string_view{long_key}, 665).second == false);
+
+        CHECK(no_of_allocations_in_thread - allocations_before == 0);
+    }
+
+    SECTION("copy stores its own keys")
+    {
+        DynamicDict copy;
+        {
+            DynamicDict temp = dd;
+            temp.insert("name", "John"s);
+            copy = temp;
+        } // keys of temp are released
+
+        CHECK(copy.size() == 3);
+        CHECK(copy.get<int>(long_key) == 42);
+        CHECK(copy.get<std::string>("name") == "John");
+
+        for (const auto& [key, value] : copy)
+            for (const auto& [original_key, original_value] : std::as_const(dd))
+                CHECK(key.data() != original_key.data());
+    }
+}
+
+TEST_CASE("columnar dict", "[columnar_dict]")
+{
+    ColumnarDict dd;
+
+    auto [pos, inserted] = dd.insert("id", 42);
+    CHECK(inserted);
+    CHECK(dd.insert("id", 665).second == false);
+    dd.insert("name", "John"s);
+    dd.insert("age", 33);
+    dd.insert("height", 1.82);
+
+    CHECK(dd.size() == 4);
+    CHECK(dd.contains("age"));
+
+    CHECK(dd.get<int>("id") == 42);
+    CHECK(dd.get<const std::string&>("name") == "John");
+    CHECK(dd.get<double>("height") == 1.82);
+    CHECK_THROWS_AS(dd.get<double>("id"), std::bad_any_cast);
+    CHECK_THROWS_AS(dd.get<int>("unknown"), std::out_of_range);
+
+    SECTION("values of one type are stored in a dense column")
+    {
+        CHECK(dd.values<int>() == std::vector{42, 33});
+        CHECK(dd.keys<int>() == std::vector<std::string_view>{"id", "age"});
+        CHECK(dd.values<std::string>() == std::vector{"John"s});
+        CHECK(dd.values<float>().empty());
+    }
+
+    SECTION("get<T&> gives access to the stored value")
+    {
+        dd.get<int&>("age") = 34;
+        CHECK(dd.values<int>()[1] == 34);
+    }
+
+    SECTION("copy")
+    {
+        ColumnarDict copy = dd;
+        copy.get<std::string&>("name") = "Jane";
+
+        CHECK(copy.get<std::string>("name") == "Jane");
+        CHECK(dd.get<std::string>("name") == "John");
+        CHECK(copy.keys<std::string>() == dd.keys<std::string>());
+        CHECK(copy.keys<std::string>()[0].data() != dd.keys<std::string>()[0].data());
+    }
+}
+
+namespace
+{
+    using namespace KeyLiterals;
+
+    constexpr KeySchema person_schema{"id", "name", "email"};
+    constexpr KeySchema order_schema{"id", "amount", "currency"};
+
+    constexpr KeySchema settings_schema{
+        "setting_0", "setting_1", "setting_2", "setting_3", "setting_4", "setting_5", "setting_6", "setting_7", "setting_8",
+        "setting_9", "setting_10", "setting_11", "setting_12", "setting_13", "setting_14", "setting_15", "setting_16",
+        "setting_17", "setting_18", "setting_19", "setting_20", "setting_21", "setting_22", "setting_23", "setting_24",
+        "setting_25", "setting_26", "setting_27", "setting_28", "setting_29", "setting_30", "setting_31", "setting_32",
+        "setting_33", "setting_34", "setting_35", "setting_36", "setting_37", "setting_38", "setting_39"};
+
+    template <typename TDict, typename TSlot, typename = void>
+    constexpr bool can_get_by_slot = false;
+
+    template <typename TDict, typename TSlot>
+    constexpr bool can_get_by_slot<TDict, TSlot, std::void_t<decltype(std::declval<TDict&>().template get<int>(std::declval<TSlot>()))>> = true;
+} // namespace
+
+TEST_CASE("key schema", "[schema_dict]")
+{
+    static_assert(person_schema.find("id"_key) != person_schema.npos);
+    static_assert(person_schema.key(person_schema.index("name"_key)) == "name");
+    static_assert(person_schema.find("age"_key) == person_schema.npos);
+    static_assert(person_schema.find("ID"_key) == person_schema.npos);
+
+    std::vector<bool> used_slots(settings_schema.no_of_keys);
+    bool all_found = true;
+    for (size_t i = 0; i < settings_schema.no_of_keys; ++i)
+    {
+        const auto index = settings_schema.find(StaticKey{"setting_" + std::to_string(i)});
+        all_found = all_found && index != settings_schema.npos && !used_slots[index] && settings_schema.key(index) == "setting_" + std::to_string(i);
+        if (index != settings_schema.npos)
+            used_slots[index] = true;
+    }
+    CHECK(all_found);
+    CHECK(settings_schema.find("setting_40"_key) == settings_schema.npos);
+
+    static_assert(!std::is_convertible_v<const char*, KeySchema<1>>);
+}
+
+TEST_CASE("schema dict", "[schema_dict]")
+{
+    SchemaDict<person_schema> dd;
+
+    CHECK(dd.insert("id"_key, 42));
+    CHECK(dd.insert("id"_key, 665) == false);
+    CHECK(dd.insert("name", "John"s));
+    CHECK(dd.insert("age"_key, 33)); // not in schema
+
+    constexpr auto id = slot_of<person_schema>("id"_key);
+    CHECK(dd.get<int>(id) == 42);
+    CHECK(dd.get<int>("id"_key) == 42);
+    CHECK(dd.get<std::string>("name"s) == "John");
+    CHECK(dd.get<int>("age"_key) == 33);
+    CHECK(dd.get<int>("age") == 33);
+
+    CHECK(dd.contains("age"));
+    CHECK(dd.contains("email"_key) == false);
+    CHECK_THROWS_AS(dd.get<std::string>("email"_key), std::out_of_range);
+    CHECK_THROWS_AS(dd.get<int>("unknown"_key), std::out_of_range);
+    CHECK_THROWS_AS(dd.get<double>(id), std::bad_any_cast);
+
+    // a slot of another schema does not compile - even for the same key in a schema of the same size
+    static_assert(can_get_by_slot<SchemaDict<person_schema>, SchemaSlot<person_schema>>);
+    static_assert(!can_get_by_slot<SchemaDict<person_schema>, SchemaSlot<order_schema>>);
+    static_assert(!can_get_by_slot<SchemaDict<person_schema>, SchemaSlot<settings_schema>>);
+    static_assert(slot_of<order_schema>("id"_key).index() == order_schema.find("id"_key));
+}
+
+TEST_CASE("concurrent dynamic dict", "[concurrent_dynamic_dict]")
+{
+    ConcurrentDynamicDict dd;
+
+    auto [pos, inserted] = dd.insert("id", 42);
+    CHECK(inserted);
+    CHECK(pos->first == "id");
+    CHECK(dd.insert("id", 665).second == false);
+    dd.insert("name", "John"s);
+
+    CHECK(dd.get<int>("id") == 42);
+    CHECK(dd.get<const std::string&>("name") == "John");
+    CHECK(dd.contains("name"));
+    CHECK_THROWS_AS(dd.get<double>("id"), std::bad_any_cast);
+    CHECK_THROWS_AS(dd.get<int>("unknown"), std::out_of_range);
+
+    SECTION("concurrent inserts & lock-free reads")
+    {
+        constexpr int NO_OF_WRITERS = 4;
+        constexpr int NO_OF_KEYS_PER_WRITER = 20'000;
+
+        std::atomic<bool> writers_done{false};
+        std::atomic<int> no_of_invalid_reads{0};
+        std::atomic<int> no_of_lost_inserts{0};
+
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r)
+            readers.emplace_back([&, r] {
+                int i = r;
+                while (!writers_done)
+                {
+                    // a key is either missing (not inserted yet) or has its value
+                    const auto key = "key_" + std::to_string(i % (NO_OF_WRITERS * NO_OF_KEYS_PER_WRITER));
+                    if (dd.contains(key) && dd.get<int>(key) != i % (NO_OF_WRITERS * NO_OF_KEYS_PER_WRITER))
+                        ++no_of_invalid_reads;
+                    i += 7;
+                }
+            });
+
+        std::vector<std::thread> writers;
+        for (int w = 0; w < NO_OF_WRITERS; ++w)
+            writers.emplace_back([&, w] {
+                for (int i = w; i < NO_OF_WRITERS * NO_OF_KEYS_PER_WRITER; i += NO_OF_WRITERS)
+                {
+                    dd.insert("key_" + std::to_string(i), i);
+                    if (!dd.contains("key_" + std::to_string(i)))
+                        ++no_of_lost_inserts;
+                }
+            });
+
+        for (auto& thd : writers)
+            thd.join();
+        writers_done = true;
+        for (auto& thd : readers)
+            thd.join();
+
+        CHECK(no_of_invalid_reads == 0);
+        CHECK(no_of_lost_inserts == 0);
+
+        bool all_found = true;
+        for (int i = 0; i < NO_OF_WRITERS * NO_OF_KEYS_PER_WRITER; ++i)
+            all_found = all_found && dd.get<int>("key_" + std::to_string(i)) == i;
+        CHECK(all_found);
+    }
+}
+
+TEST_CASE("any_cast - std::any vs inplace_any", "[.][benchmark]")
+{
+    constexpr int NO_OF_CASTS = 1'000;
+
+    std::vector<std::any> std_values;
+    std::vector<inplace_any<>> inplace_values;
+    for (int i = 0; i < NO_OF_CASTS; ++i)
+    {
+        std_values.push_back(i);
+        inplace_values.push_back(i);
+    }
+
+    BENCHMARK("std::any_cast<int> - hit")
+    {
+        long sum = 0;
+        for (const auto& value : std_values)
+            sum += *std::any_cast<int>(&value);
+        return sum;
+    };
+
+    BENCHMARK("any_cast<int>(inplace_any) - hit")
+    {
+        long sum = 0;
+        for (const auto& value : inplace_values)
+            sum += *any_cast<int>(&value);
+        return sum;
+    };
+
+    BENCHMARK("std::any_cast<double> - miss")
+    {
+        int no_of_misses = 0;
+        for (const auto& value : std_values)
+            no_of_misses += std::any_cast<double>(&value) == nullptr;
+        return no_of_misses;
+    };
+
+    BENCHMARK("any_cast<double>(inplace_any) - miss")
+    {
+        int no_of_misses = 0;
+        for (const auto& value : inplace_values)
+            no_of_misses += any_cast<double>(&value) == nullptr;
+        return no_of_misses;
+    };
+}
+
+namespace
+{
+    struct Point
+    {
+        double x, y, z;
+    };
+
+    // typical configuration values - ints, doubles, strings and small structs
+    template <typename TAny>
+    BasicDynamicDict<TAny> make_dict(int no_of_items)
+    {
+        BasicDynamicDict<TAny> dd;
+
+        for (int i = 0; i < no_of_items; ++i)
+        {
+            auto key = "key_" + std::to_string(i);
+
+            switch (i % 4)
+            {
+            case 0:
+                dd.insert(std::move(key), i);
+                break;
+            case 1:
+                dd.insert(std::move(key), i * 0.5);
+                break;
+            case 2:
+                dd.insert(std::move(key), "value_" + std::to_string(i));
+                break;
+            default:
+                dd.insert(std::move(key), Point{1.0 * i, 2.0 * i, 3.0 * i});
+            }
+        }
+
+        return dd;
+    }
+} // namespace
+
+TEMPLATE_TEST_CASE("dynamic dict - std::any vs inplace_any", "[.][benchmark]", std::any, inplace_any<>)
+{
+    constexpr int NO_OF_ITEMS = 10'000;
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < NO_OF_ITEMS; ++i)
+        keys.push_back("key_" + std::to_string(i));
+
+    BENCHMARK("insert")
+    {
+        return make_dict<TestType>(NO_OF_ITEMS);
+    };
+
+    auto dd = make_dict<TestType>(NO_OF_ITEMS);
+
+    BENCHMARK("lookup")
+    {
+        double sum = 0.0;
+        for (int i = 0; i < NO_OF_ITEMS; ++i)
+        {
+            switch (i % 4)
+            {
+            case 0:
+                sum += dd.template get<int>(keys[i]);
+                break;
+            case 1:
+                sum += dd.template get<double>(keys[i]);
+                break;
+            case 2:
+                sum += dd.template get<const std::string&>(keys[i]).size();
+                break;
+            default:
+                sum += dd.template get<const Point&>(keys[i]).z;
+            }
+        }
+        return sum;
+    };
+
+    BENCHMARK("copy")
+    {
+        return BasicDynamicDict<TestType>{dd};
+    };
+}
+
+TEST_CASE("dynamic dict vs columnar dict", "[.][benchmark]")
+{
+    constexpr int NO_OF_ITEMS = 1'000'000;
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < NO_OF_ITEMS; ++i)
+        keys.push_back("key_" + std::to_string(i));
+
+    DynamicDict dynamic_dict;
+    ColumnarDict columnar_dict;
+    for (int i = 0; i < NO_OF_ITEMS; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            dynamic_dict.insert(keys[i], i);
+            columnar_dict.insert(keys[i], i);
+        }
+        else
+        {
+            dynamic_dict.insert(keys[i], "value_" + std::to_string(i));
+            columnar_dict.insert(keys[i], "value_" + std::to_string(i));
+        }
+    }
+
+    BENCHMARK("DynamicDict - get<int> by key")
+    {
+        long sum = 0;
+        for (int i = 0; i < NO_OF_ITEMS; i += 2)
+            sum += dynamic_dict.get<int>(keys[i]);
+        return sum;
+    };
+
+    BENCHMARK("ColumnarDict - get<int> by key")
+    {
+        long sum = 0;
+        for (int i = 0; i < NO_OF_ITEMS; i += 2)
+            sum += columnar_dict.get<int>(keys[i]);
+        return sum;
+    };
+
+    BENCHMARK("ColumnarDict - scan of values<int>()")
+    {
+        const auto& values = columnar_dict.values<int>();
+        return std::accumulate(values.begin(), values.end(), 0L);
+    };
+}
+
+TEST_CASE("dynamic dict vs schema dict", "[.][benchmark]")
+{
+    DynamicDict dynamic_dict;
+    dynamic_dict.insert("id", 42);
+    dynamic_dict.insert("name", "John"s);
+
+    SchemaDict<person_schema> schema_dict;
+    schema_dict.insert("id"_key, 42);
+    schema_dict.insert("name"_key, "John"s);
+
+    // typical size of a configuration - small maps are searched linearly by std::unordered_map
+    for (int i = 0; i < 40; ++i)
+    {
+        dynamic_dict.insert("setting_" + std::to_string(i), i);
+        schema_dict.insert("setting_" + std::to_string(i), i);
+    }
+
+    constexpr int NO_OF_LOOKUPS = 1'000;
+
+    BENCHMARK("DynamicDict - get<int>(\"id\")")
+    {
+        long sum = 0;
+        for (int i = 0; i < NO_OF_LOOKUPS; ++i)
+            sum += dynamic_dict.get<int>("id");
+        return sum;
+    };
+
+    BENCHMARK("SchemaDict - get<int>(\"id\"_key)")
+    {
+        long sum = 0;
+        for (int i = 0; i < NO_OF_LOOKUPS; ++i)
+            sum += schema_dict.get<int>("id"_key);
+        return sum;
+    };
+
+    BENCHMARK("SchemaDict - get<int>(slot)")
+    {
+        constexpr auto id = slot_of<person_schema>("id"_key);
+
+        long sum = 0;
+        for (int i = 0; i < NO_OF_LOOKUPS; ++i)
+            sum += schema_dict.get<int>(id);
+        return sum;
+    };
+}
+
+TEST_CASE("read-mostly dict from many threads - shared_mutex vs ConcurrentDynamicDict", "[.][benchmark]")
+{
+    constexpr int NO_OF_KEYS = 10'000;
+    constexpr int NO_OF_OPERATIONS = 10'000; // per thread - 1% inserts, 99% reads
+    constexpr int MAX_NO_OF_THREADS = 64;
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < NO_OF_KEYS; ++i)
+        keys.push_back("key_" + std::to_string(i));
+
+    auto run_threads = [&](int no_of_threads, auto insert, auto get) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < no_of_threads; ++t)
+            threads.emplace_back([&, t] {
+                long sum = 0;
+                for (int i = 0; i < NO_OF_OPERATIONS; ++i)
+                {
+                    if (i % 100 == 0)
+                        insert("thread_" + std::to_string(t) + "_" + std::to_string(i), i);
+                    else
+                        sum += get(keys[(t * 7919 + i) % NO_OF_KEYS]);
+                }
+                return sum;
+            });
+
+        for (auto& thd : threads)
+            thd.join();
+    };
+
+    // shows scaling only on a machine with many cores - with fewer cores than threads they just time-slice
+    for (int no_of_threads = 1; no_of_threads <= MAX_NO_OF_THREADS; no_of_threads *= 2)
+    {
+        BENCHMARK_ADVANCED("std::shared_mutex + DynamicDict - " + std::to_string(no_of_threads) + " threads")(Catch::Benchmark::Chronometer meter)
+        {
+            DynamicDict dd;
+            std::shared_mutex mtx_dd;
+            for (int i = 0; i < NO_OF_KEYS; ++i)
+                dd.insert(keys[i], i);
+
+            meter.measure([&] {
+                run_threads(
+                    no_of_threads,
+                    [&](const std::string& key, int value) {
+                        std::unique_lock lk{mtx_dd};
+                        dd.insert(key, value);
+                    },
+                    [&](const std::string& key) {
+                        std::shared_lock lk{mtx_dd};
+                        return dd.get<int>(key);
+                    });
+            });
+        };
+
+        BENCHMARK_ADVANCED("ConcurrentDynamicDict - " + std::to_string(no_of_threads) + " threads")(Catch::Benchmark::Chronometer meter)
+        {
+            ConcurrentDynamicDict dd;
+            for (int i = 0; i < NO_OF_KEYS; ++i)
+                dd.insert(keys[i], i);
+
+            meter.measure([&] {
+                run_threads(
+                    no_of_threads,
+                    [&](const std::string& key, int value) { dd.insert(key, value); },
+                    [&](const std::string& key) { return dd.get<int>(key); });
+            });
+        };
+    }
+}
+
+TEST_CASE("dynamic dict lookup - std::unordered_map vs FlatHashMap", "[.][benchmark]")
+{
+    constexpr int NO_OF_LOOKUPS = 10'000;
+
+    for (int no_of_keys : {1'000, 1'000'000, 10'000'000})
+    {
+        std::vector<std::string> keys;
+        keys.reserve(no_of_keys);
+        for (int i = 0; i < no_of_keys; ++i)
+            keys.push_back("key_" + std::to_string(i));
+
+        std::mt19937_64 rnd_gen{665};
+        std::uniform_int_distribution<int> rnd_index{0, no_of_keys - 1};
+        std::vector<std::string_view> lookup_keys;
+        for (int i = 0; i < NO_OF_LOOKUPS; ++i)
+            lookup_keys.push_back(keys[rnd_index(rnd_gen)]);
+
+        auto benchmark_lookup = [&](auto map, const std::string& name) {
+            for (int i = 0; i < no_of_keys; ++i)
+                map.emplace(std::string_view{keys[i]}, std::any{i});
+
+            BENCHMARK(name + " - " + std::to_string(no_of_keys) + " keys")
+            {
+                long sum = 0;
+                for (auto key : lookup_keys)
+                    sum += std::any_cast<int>(map.at(key));
+                return sum;
+            };
+        };
+
+        benchmark_lookup(std::unordered_map<std::string_view, std::any>{}, "std::unordered_map");
+        benchmark_lookup(FlatHashMap<std::string_view, std::any>{}, "FlatHashMap");
+    }
+}
+
+#if __has_include(<sys/mman.h>)
+
+TEST_CASE("dict snapshot", "[dict_snapshot]")
+{
+    const auto snapshot_path = (std::filesystem::temp_directory_path() / "tests_dynamic_dict_snapshot.bin").string();
+
+    // temporary files are named <path>.XXXXXX
+    auto no_of_files_starting_with = [](const std::string& path_prefix) {
+        const std::filesystem::path prefix{path_prefix};
+        const auto name_prefix = prefix.filename().string();
+
+        std::size_t count = 0;
+        for (const auto& entry : std::filesystem::directory_iterator{prefix.parent_path()})
+            if (entry.path().filename().string().compare(0, name_prefix.size(), name_prefix) == 0)
+                ++count;
+        return count;
+    };
+
+    DynamicDict dd;
+    dd.insert("id", 42);
+    dd.insert("timestamp", std::int64_t{1'686'000'000'000});
+    dd.insert("height", 1.82);
+    dd.insert("name", "John"s);
+    dd.insert("empty", ""s);
+    dd.insert("scores", std::vector{1, 2, 3});
+    dd.insert("weights", std::vector{0.5, 0.25});
+
+    save_snapshot(dd, snapshot_path);
+
+    DictSnapshot snapshot{snapshot_path};
+
+    CHECK(snapshot.size() == dd.size());
+    CHECK(snapshot.contains("name"));
+    CHECK(snapshot.contains("unknown") == false);
+
+    CHECK(snapshot.get<int>("id") == 42);
+    CHECK(snapshot.get<std::int64_t>("timestamp") == 1'686'000'000'000);
+    CHECK(snapshot.get<double>("height") == 1.82);
+    CHECK(snapshot.get<std::string>("name") == "John");
+    CHECK(snapshot.get<std::string_view>("name") == "John");
+    CHECK(snapshot.get<std::string>("empty").empty());
+    CHECK(snapshot.get<std::vector<int>>("scores") == std::vector{1, 2, 3});
+    CHECK(snapshot.get<std::vector<double>>("weights") == std::vector{0.5, 0.25});
+
+    CHECK_THROWS_AS(snapshot.get<double>("id"), std::bad_any_cast);
+    CHECK_THROWS_AS(snapshot.get<int>("unknown"), std::out_of_range);
+
+    SECTION("values of unregistered types cannot be saved")
+    {
+        dd.insert("point", Point{1, 2, 3});
+        CHECK_THROWS_AS(save_snapshot(dd, snapshot_path + ".invalid"), std::invalid_argument);
+        CHECK(no_of_files_starting_with(snapshot_path + ".invalid") == 0);
+    }
+
+    SECTION("saving replaces the file - a mapped snapshot keeps its contents")
+    {
+        DynamicDict other;
+        other.insert("id", 665);
+        save_snapshot(other, snapshot_path);
+
+        CHECK(snapshot.get<int>("id") == 42);
+        CHECK(DictSnapshot{snapshot_path}.get<int>("id") == 665);
+        CHECK(no_of_files_starting_with(snapshot_path + ".") == 0);
+    }
+
+    SECTION("corrupt files are detected")
+    {
+        const auto corrupt_path = snapshot_path + ".invalid";
+        std::filesystem::copy_file(snapshot_path, corrupt_path, std::filesystem::copy_options::overwrite_existing);
+
+        Detail::SnapshotHeader header{};
+        std::fstream file{corrupt_path, std::ios::in | std::ios::out | std::ios::binary};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        auto fill_table = [&](std::uint64_t offset) {
+            file.seekp(static_cast<std::streamoff>(header.table_offset));
+            for (std::uint64_t i = 0; i < header.table_capacity; ++i)
+                file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+            file.flush();
+        };
+
+        SECTION("entry offset outside of the file")
+        {
+            fill_table(std::uint64_t{1} << 40);
+
+            DictSnapshot corrupt{corrupt_path};
+            CHECK_THROWS_AS(corrupt.get<int>("id"), std::runtime_error);
+            CHECK_THROWS_AS(corrupt.contains("unknown"), std::runtime_error);
+        }
+
+        SECTION("table without empty slots - probing stops after table capacity")
+        {
+            fill_table(sizeof(Detail::SnapshotHeader)); // every slot points to the first entry
+
+            DictSnapshot corrupt{corrupt_path};
+            CHECK(corrupt.contains("unknown") == false);
+        }
+
+        SECTION("other format version")
+        {
+            header.version = Detail::snapshot_version + 1;
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.flush();
+
+            CHECK_THROWS_AS(DictSnapshot{corrupt_path}, std::runtime_error);
+        }
+    }
+
+    SECTION("other files are rejected")
+    {
+        {
+            std::ofstream out{snapshot_path + ".invalid"};
+            out << "id=42\nname=John\nheight=1.82\n";
+        }
+        CHECK_THROWS_AS(DictSnapshot{snapshot_path + ".invalid"}, std::runtime_error);
+    }
+
+    std::filesystem::remove(snapshot_path + ".invalid");
+    std::filesystem::remove(snapshot_path);
+}
+
+TEST_CASE("startup with 1M entries - re-inserting vs mapped snapshot", "[.][benchmark]")
+{
+    constexpr int NO_OF_ITEMS = 1'000'000;
+
+    const auto snapshot_path = (std::filesystem::temp_directory_path() / "tests_dynamic_dict_startup.bin").string();
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < NO_OF_ITEMS; ++i)
+        keys.push_back("key_" + std::to_string(i));
+
+    auto build_dict = [&] {
+        DynamicDict dd;
+        for (int i = 0; i < NO_OF_ITEMS; ++i)
+        {
+            if (i % 2 == 0)
+                dd.insert(keys[i], i);
+            else
+                dd.insert(keys[i], "value_" + std::to_string(i));
+        }
+        return dd;
+    };
+
+    save_snapshot(build_dict(), snapshot_path);
+
+    BENCHMARK("re-inserting every entry")
+    {
+        auto dd = build_dict();
+        return dd.get<int>("key_0");
+    };
+
+    BENCHMARK("mapping a snapshot")
+    {
+        DictSnapshot snapshot{snapshot_path};
+        return snapshot.get<int>("key_0");
+    };
+
+    std::filesystem::remove(snapshot_path);
+}
+
+#endif
@@ -0,0 +1,605 @@
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "async_notifier.hpp"
+#include "event_bus.hpp"
+#include "observer_registry.hpp"
+#include "sampled_notifier.hpp"
+#include "temp_monitor.hpp"
+
+using namespace std;
+
+namespace
+{
+    struct Alarm
+    {
+        double threshold;
+    };
+
+    struct TemperatureLogger
+    {
+        std::vector<double> samples;
+        int no_of_alarms = 0;
+
+        void on(const TemperatureSample& sample)
+        {
+            samples.push_back(sample.value);
+        }
+
+        void on(const Alarm&)
+        {
+            ++no_of_alarms;
+        }
+    };
+
+    struct TemperatureSum
+    {
+        double sum = 0.0;
+
+        void on(const TemperatureSample& sample)
+        {
+            sum += sample.value;
+        }
+    };
+}
+
+TEST_CASE("event bus", "[observers]")
+{
+    EventBus bus;
+    TempMonitor monitor;
+    TemperatureLogger logger;
+
+    bus.subscribe<TemperatureSample>(logger);
+    bus.subscribe<Alarm>(logger);
+
+    SECTION("observers get events of subscribed types")
+    {
+        monitor.notify(bus);
+        bus.publish(Alarm{30.0});
+
+        CHECK(logger.samples == std::vector{23.88});
+        CHECK(logger.no_of_alarms == 1);
+    }
+
+    SECTION("unsubscribe")
+    {
+        bus.unsubscribe<TemperatureSample>(logger);
+
+        monitor.notify(bus);
+        bus.publish(Alarm{30.0});
+
+        CHECK(logger.samples.empty());
+        CHECK(logger.no_of_alarms == 1);
+        CHECK(bus.no_of_subscribers<TemperatureSample>() == 0);
+    }
+
+    SECTION("events without subscribers are ignored")
+    {
+        bus.publish(42);
+        CHECK(bus.no_of_subscribers<int>() == 0);
+    }
+}
+
+TEST_CASE("event bus - notify does not allocate", "[observers]")
+{
+    EventBus bus;
+    TempMonitor monitor;
+    std::vector<TemperatureSum> observers(10);
+    for (auto& o : observers)
+        bus.subscribe<TemperatureSample>(o);
+
+    const auto allocations_before = no_of_allocations_in_thread;
+
+    for (int i = 0; i < 1'000; ++i)
+        monitor.notify(bus);
+
+    CHECK(no_of_allocations_in_thread - allocations_before == 0);
+    CHECK(observers[9].sum > 0.0);
+}
+
+namespace
+{
+    class RecordingObserver : public Observer
+    {
+        std::chrono::microseconds delay_;
+
+    public:
+        std::vector<double> temps;
+
+        explicit RecordingObserver(std::chrono::microseconds delay = std::chrono::microseconds{0})
+            : delay_{delay}
+        {
+        }
+
+        void update(std::any sender, const string& msg) override
+        {
+            if (std::any_cast<TempMonitor*>(&sender))
+                temps.push_back(std::stod(msg));
+
+            if (delay_.count() > 0)
+                std::this_thread::sleep_for(delay_);
+        }
+    };
+
+    // blocks every update until the gate is opened
+    class GatedObserver : public Observer
+    {
+        std::mutex mtx_gate_;
+        std::condition_variable cv_gate_;
+        bool is_open_ = false;
+
+    public:
+        void update(std::any, const string&) override
+        {
+            std::unique_lock lk{mtx_gate_};
+            cv_gate_.wait(lk, [this] { return is_open_; });
+        }
+
+        void open()
+        {
+            {
+                std::lock_guard lk{mtx_gate_};
+                is_open_ = true;
+            }
+            cv_gate_.notify_all();
+        }
+    };
+
+    // simulates an expensive observer without giving up the CPU
+    class BusyObserver : public Observer
+    {
+        std::chrono::microseconds cost_;
+
+    public:
+        explicit BusyObserver(std::chrono::microseconds cost)
+            : cost_{cost}
+        {
+        }
+
+        void update(std::any, const string&) override
+        {
+            const auto deadline = std::chrono::steady_clock::now() + cost_;
+            while (std::chrono::steady_clock::now() < deadline)
+                ;
+        }
+    };
+}
+
+TEST_CASE("async notifier", "[observers]")
+{
+    using namespace std::chrono_literals;
+
+    constexpr int NO_OF_SAMPLES = 1'000;
+
+    TempMonitor monitor;
+    AsyncNotifier notifier;
+
+    SECTION("backpressure - all events are delivered in order")
+    {
+        RecordingObserver observer;
+        notifier.subscribe(observer, DeliveryOptions{16, OverflowPolicy::block, 4});
+
+        for (int i = 0; i < NO_OF_SAMPLES; ++i)
+        {
+            monitor.set_temp(i);
+            notifier.notify(monitor);
+        }
+        notifier.wait_until_idle();
+
+        REQUIRE(observer.temps.size() == NO_OF_SAMPLES);
+        CHECK(observer.temps.front() == 0.0);
+        CHECK(observer.temps.back() == NO_OF_SAMPLES - 1);
+        CHECK(notifier.stats(observer).dropped == 0);
+    }
+
+    SECTION("slow observer - events are dropped, fast observer gets all")
+    {
+        RecordingObserver slow_observer{100us};
+        RecordingObserver fast_observer;
+        notifier.subscribe(slow_observer, DeliveryOptions{8, OverflowPolicy::drop_newest, 4});
+        notifier.subscribe(fast_observer, DeliveryOptions{NO_OF_SAMPLES, OverflowPolicy::drop_newest, 64});
+
+        for (int i = 0; i < NO_OF_SAMPLES; ++i)
+        {
+            monitor.set_temp(i);
+            notifier.notify(monitor);
+        }
+        notifier.stop();
+
+        const auto slow_stats = notifier.stats(slow_observer);
+        CHECK(slow_stats.dropped > 0);
+        CHECK(slow_stats.delivered + slow_stats.dropped == NO_OF_SAMPLES);
+        CHECK(slow_observer.temps.size() == slow_stats.delivered);
+
+        CHECK(fast_observer.temps.size() == NO_OF_SAMPLES);
+    }
+
+    SECTION("drop oldest - the latest value is always delivered")
+    {
+        RecordingObserver slow_observer{100us};
+        notifier.subscribe(slow_observer, DeliveryOptions{4, OverflowPolicy::drop_oldest, 2});
+
+        for (int i = 0; i < NO_OF_SAMPLES; ++i)
+        {
+            monitor.set_temp(i);
+            notifier.notify(monitor);
+        }
+        notifier.wait_until_idle();
+
+        REQUIRE_FALSE(slow_observer.temps.empty());
+        CHECK(slow_observer.temps.back() == NO_OF_SAMPLES - 1);
+        CHECK(notifier.stats(slow_observer).dropped > 0);
+    }
+
+    SECTION("stop wakes up blocked producers - events after stop are dropped")
+    {
+        GatedObserver observer;
+        notifier.subscribe(observer, DeliveryOptions{1, OverflowPolicy::block, 1});
+
+        notifier.notify(monitor); // taken by the worker - blocks in update()
+        notifier.notify(monitor); // waits in the ring (it may wait for the worker to take the first one)
+
+        std::thread blocked_producer{[&] { notifier.notify(monitor); }}; // full ring - blocks until stop
+        std::thread gate_keeper{[&] {
+            blocked_producer.join();
+            observer.open();
+        }};
+
+        std::this_thread::sleep_for(10ms);
+        notifier.stop();
+        gate_keeper.join();
+
+        notifier.notify(monitor);
+
+        const auto stats = notifier.stats(observer);
+        CHECK(stats.delivered == 2);
+        CHECK(stats.dropped == 2);
+    }
+}
+
+TEST_CASE("async notifier - delivered counts only finished updates", "[observers]")
+{
+    TempMonitor monitor;
+    GatedObserver observer;
+    AsyncNotifier notifier;
+    notifier.subscribe(observer, DeliveryOptions{4, OverflowPolicy::block, 4});
+
+    notifier.notify(monitor);
+    std::this_thread::sleep_for(std::chrono::milliseconds{10}); // the worker is in update()
+
+    CHECK(notifier.stats(observer).delivered == 0);
+
+    observer.open();
+    notifier.wait_until_idle();
+
+    CHECK(notifier.stats(observer).delivered == 1);
+}
+
+namespace
+{
+    class CountingObserver : public Observer
+    {
+    public:
+        std::atomic<int> no_of_updates{0};
+        std::atomic<bool> is_unsubscribed{false};
+        std::atomic<bool> updated_after_unsubscribe{false};
+
+        void update(std::any, const string&) override
+        {
+            if (is_unsubscribed)
+                updated_after_unsubscribe = true;
+            ++no_of_updates;
+        }
+    };
+}
+
+TEST_CASE("observer registry", "[observers]")
+{
+    TempMonitor monitor;
+    ObserverRegistry registry;
+    RecordingObserver observer1;
+    RecordingObserver observer2;
+
+    registry.subscribe(observer1);
+    registry.subscribe(observer2);
+    REQUIRE(registry.size() == 2);
+
+    registry.notify(monitor);
+    registry.unsubscribe(observer1);
+    registry.notify(monitor);
+
+    CHECK(observer1.temps == std::vector{23.88});
+    CHECK(observer2.temps == std::vector{23.88, 23.88});
+    CHECK(registry.size() == 1);
+}
+
+TEST_CASE("observer registry - concurrent subscribe, unsubscribe & notify", "[observers]")
+{
+    constexpr int NO_OF_NOTIFIERS = 3;
+    constexpr int NO_OF_SUBSCRIBERS = 3;
+    constexpr int NO_OF_ROUNDS = 300;
+
+    TempMonitor monitor;
+    ObserverRegistry registry;
+    CountingObserver permanent_observer;
+    registry.subscribe(permanent_observer);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> no_of_violations{0};
+
+    std::vector<std::thread> notifiers;
+    for (int i = 0; i < NO_OF_NOTIFIERS; ++i)
+        notifiers.emplace_back([&] {
+            while (!done)
+                registry.notify(&monitor, "23.88");
+        });
+
+    std::vector<std::thread> subscribers;
+    for (int i = 0; i < NO_OF_SUBSCRIBERS; ++i)
+        subscribers.emplace_back([&] {
+            for (int round = 0; round < NO_OF_ROUNDS; ++round)
+            {
+                auto observer = std::make_unique<CountingObserver>();
+                registry.subscribe(*observer);
+                std::this_thread::yield();
+                registry.unsubscribe(*observer);
+
+                observer->is_unsubscribed = true;
+                std::this_thread::yield();
+                if (observer->updated_after_unsubscribe)
+                    ++no_of_violations;
+            } // observer is destroyed right after unsubscribe
+        });
+
+    for (auto& thd : subscribers)
+        thd.join();
+
+    done = true;
+    for (auto& thd : notifiers)
+        thd.join();
+
+    CHECK(no_of_violations == 0);
+    CHECK(permanent_observer.no_of_updates > 0);
+    CHECK(registry.size() == 1);
+}
+
+TEST_CASE("sampled notifier", "[observers]")
+{
+    using namespace std::chrono_literals;
+
+    TempMonitor monitor;
+    SampledNotifier notifier{monitor};
+    RecordingObserver observer;
+    const auto t0 = SampledNotifier::clock::time_point{} + 1h;
+
+    auto read = [&](double temp, std::chrono::milliseconds at) {
+        monitor.set_temp(temp);
+        notifier.notify(t0 + at);
+    };
+
+    SECTION("deadband")
+    {
+        notifier.subscribe(observer, SamplingPolicy{0.5, 0ms});
+
+        read(20.0, 0ms);
+        read(20.3, 1ms);
+        read(20.5, 2ms);
+        read(20.6, 3ms);
+        read(20.0, 4ms);
+
+        CHECK(observer.temps == std::vector{20.0, 20.6, 20.0});
+    }
+
+    SECTION("rate limit coalesces bursts into the latest value")
+    {
+        notifier.subscribe(observer, SamplingPolicy{0.0, 100ms});
+
+        read(20.0, 0ms);
+        read(21.0, 10ms);
+        read(22.0, 20ms);
+        read(23.0, 30ms);
+        notifier.tick(t0 + 50ms);
+        CHECK(observer.temps == std::vector{20.0});
+
+        notifier.tick(t0 + 100ms);
+        CHECK(observer.temps == std::vector{20.0, 23.0});
+
+        read(24.0, 250ms);
+        CHECK(observer.temps == std::vector{20.0, 23.0, 24.0});
+    }
+
+    SECTION("final value is not stale")
+    {
+        notifier.subscribe(observer, SamplingPolicy{0.1, 100ms});
+
+        read(20.0, 0ms);
+        read(25.0, 10ms);
+        notifier.flush(t0 + 20ms);
+
+        CHECK(observer.temps.back() == 25.0);
+    }
+
+    SECTION("pending value is dropped when reading returns to the last sent value")
+    {
+        notifier.subscribe(observer, SamplingPolicy{0.1, 100ms});
+
+        read(20.0, 0ms);
+        read(25.0, 10ms);
+        read(20.05, 20ms);
+        notifier.tick(t0 + 200ms);
+
+        CHECK(observer.temps == std::vector{20.0});
+    }
+
+    SECTION("every observer has its own policy")
+    {
+        RecordingObserver raw_observer;
+        notifier.subscribe(observer, SamplingPolicy{1.0, 0ms});
+        notifier.subscribe(raw_observer);
+
+        for (int i = 0; i < 10; ++i)
+            read(20.0 + i * 0.25, std::chrono::milliseconds{i});
+
+        CHECK(raw_observer.temps.size() == 10);
+        CHECK(observer.temps == std::vector{20.0, 21.25});
+    }
+}
+
+TEST_CASE("notify - std::any observers vs typed event bus", "[.][benchmark]")
+{
+    for (int no_of_observers : {1, 10, 1000})
+    {
+        TempMonitor monitor;
+        std::vector<Logger> loggers(no_of_observers);
+        for (auto& logger : loggers)
+            monitor.subscribe(&logger);
+
+        EventBus bus;
+        std::vector<TemperatureSum> observers(no_of_observers);
+        for (auto& o : observers)
+            bus.subscribe<TemperatureSample>(o);
+
+        BENCHMARK("Observer::update(std::any, std::string) - " + std::to_string(no_of_observers) + " observers")
+        {
+            monitor.notify();
+        };
+
+        BENCHMARK("EventBus::publish - " + std::to_string(no_of_observers) + " observers")
+        {
+            monitor.notify(bus);
+            return observers.back().sum;
+        };
+    }
+}
+
+TEST_CASE("notify latency - synchronous vs asynchronous observers", "[.][benchmark]")
+{
+    using namespace std::chrono_literals;
+
+    for (auto observer_cost : {0us, 10us, 100us})
+    {
+        const auto name = std::to_string(observer_cost.count()) + "us per update";
+
+        BusyObserver sync_observer{observer_cost};
+        TempMonitor sync_monitor;
+        sync_monitor.subscribe(&sync_observer);
+
+        BENCHMARK("synchronous notify - " + name)
+        {
+            sync_monitor.notify();
+        };
+
+        BusyObserver async_observer{observer_cost};
+        TempMonitor async_monitor;
+        AsyncNotifier notifier;
+        notifier.subscribe(async_observer, DeliveryOptions{1024, OverflowPolicy::drop_oldest, 64});
+
+        BENCHMARK("asynchronous notify - " + name)
+        {
+            notifier.notify(async_monitor);
+        };
+    }
+}
+
+TEST_CASE("notify from many threads - mutex-guarded vector vs RCU registry", "[.][benchmark]")
+{
+    constexpr int NO_OF_NOTIFICATIONS = 10'000;
+    constexpr int NO_OF_OBSERVERS = 10;
+
+    std::vector<CountingObserver> observers(NO_OF_OBSERVERS);
+
+    std::vector<Observer*> locked_observers;
+    std::mutex mtx_observers;
+    ObserverRegistry registry;
+    for (auto& o : observers)
+    {
+        locked_observers.push_back(&o);
+        registry.subscribe(o);
+    }
+
+    auto run_notifiers = [](int no_of_threads, auto notify) {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < no_of_threads; ++i)
+            threads.emplace_back([&notify] {
+                for (int n = 0; n < NO_OF_NOTIFICATIONS; ++n)
+                    notify();
+            });
+
+        for (auto& thd : threads)
+            thd.join();
+    };
+
+    const int max_no_of_threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+
+    for (int no_of_threads = 1; no_of_threads <= max_no_of_threads; no_of_threads *= 2)
+    {
+        BENCHMARK("std::mutex + std::vector<Observer*> - " + std::to_string(no_of_threads) + " notifiers")
+        {
+            run_notifiers(no_of_threads, [&] {
+                std::lock_guard lk{mtx_observers};
+                for (Observer* o : locked_observers)
+                    o->update(nullptr, "23.88");
+            });
+        };
+
+        BENCHMARK("ObserverRegistry - " + std::to_string(no_of_threads) + " notifiers")
+        {
+            run_notifiers(no_of_threads, [&] { registry.notify(nullptr, "23.88"); });
+        };
+    }
+}
+
+TEST_CASE("observer CPU on sensor trace - raw vs sampled notifications", "[.][benchmark]")
+{
+    using namespace std::chrono_literals;
+
+    constexpr int NO_OF_READINGS = 10'000;
+
+    // 1kHz sensor: slow drift + small noise
+    std::vector<double> trace;
+    for (int i = 0; i < NO_OF_READINGS; ++i)
+        trace.push_back(20.0 + 5.0 * std::sin(i / 2'000.0) + 0.05 * std::sin(i * 7.0));
+
+    const auto t0 = SampledNotifier::clock::now();
+
+    BENCHMARK("raw notify")
+    {
+        TempMonitor monitor;
+        BusyObserver observer{1us};
+        monitor.subscribe(&observer);
+
+        for (const auto temp : trace)
+        {
+            monitor.set_temp(temp);
+            monitor.notify();
+        }
+    };
+
+    BENCHMARK("sampled notify - deadband 0.1, max 100 notifications/s")
+    {
+        TempMonitor monitor;
+        BusyObserver observer{1us};
+        SampledNotifier notifier{monitor};
+        notifier.subscribe(observer, SamplingPolicy{0.1, 10ms});
+
+        for (int i = 0; i < NO_OF_READINGS; ++i)
+        {
+            const auto now = t0 + std::chrono::milliseconds{i};
+            monitor.set_temp(trace[i]);
+            notifier.notify(now);
+            notifier.tick(now);
+        }
+        notifier.flush();
+    };
+}
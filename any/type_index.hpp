@@ -0,0 +1,30 @@
+#ifndef TYPE_INDEX_HPP
+#define TYPE_INDEX_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace Detail
+{
+    // dense index of a type (0, 1, 2, ...) - no RTTI, no hashing
+    // - every TFamily (e.g. event types of EventBus) is numbered separately, so its indexes stay small
+    template <typename TFamily>
+    class DenseTypeIndex
+    {
+        static std::size_t next()
+        {
+            static std::atomic<std::size_t> counter{0};
+            return counter++;
+        }
+
+    public:
+        template <typename T>
+        static std::size_t of()
+        {
+            static const std::size_t index = next();
+            return index;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef ACCOUNT_LEDGER_HPP
+#define ACCOUNT_LEDGER_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "cache_line.hpp"
+
+// Many accounts in one object: balances are stored contiguously (8 per cache line)
+// and guarded by a fixed number of striped locks
+// - all accounts sharing a cache line are guarded by the same stripe, so two threads
+//   holding different stripes never write to the same cache line (no false sharing)
+// - every lock sits in its own cache line
+class AccountLedger
+{
+public:
+    using account_id = std::size_t;
+
+private:
+    static constexpr std::size_t accounts_per_line = cache_line_size / sizeof(double);
+
+    struct alignas(cache_line_size) BalanceLine
+    {
+        double balances[accounts_per_line]{};
+    };
+
+    struct alignas(cache_line_size) Stripe
+    {
+        std::mutex mtx;
+    };
+
+    std::size_t size_;
+    std::vector<BalanceLine> lines_;
+    mutable std::vector<Stripe> stripes_;
+
+    double& balance_ref(account_id id)
+    {
+        return lines_[id / accounts_per_line].balances[id % accounts_per_line];
+    }
+
+    const double& balance_ref(account_id id) const
+    {
+        return lines_[id / accounts_per_line].balances[id % accounts_per_line];
+    }
+
+    std::size_t stripe_index(account_id id) const
+    {
+        return (id / accounts_per_line) % stripes_.size();
+    }
+
+    std::mutex& stripe_mutex(account_id id) const
+    {
+        return stripes_[stripe_index(id)].mtx;
+    }
+
+public:
+    AccountLedger(std::size_t no_of_accounts, double initial_balance, std::size_t no_of_stripes = 64)
+        : size_{no_of_accounts}
+        , lines_((no_of_accounts + accounts_per_line - 1) / accounts_per_line)
+        , stripes_(std::max<std::size_t>(no_of_stripes, 1))
+    {
+        for (account_id id = 0; id < size_; ++id)
+            balance_ref(id) = initial_balance;
+    }
+
+    AccountLedger(const AccountLedger&) = delete;
+    AccountLedger& operator=(const AccountLedger&) = delete;
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    std::size_t no_of_stripes() const
+    {
+        return stripes_.size();
+    }
+
+    void deposit(account_id id, double amount)
+    {
+        assert(id < size_);
+
+        std::lock_guard lk{stripe_mutex(id)};
+        balance_ref(id) += amount;
+    }
+
+    void withdraw(account_id id, double amount)
+    {
+        assert(id < size_);
+
+        std::lock_guard lk{stripe_mutex(id)};
+        balance_ref(id) -= amount;
+    }
+
+    void transfer(account_id from, account_id to, double amount)
+    {
+        assert(from < size_ && to < size_);
+
+        const auto from_stripe = stripe_index(from);
+        const auto to_stripe = stripe_index(to);
+
+        if (from_stripe == to_stripe)
+        {
+            std::lock_guard lk{stripes_[from_stripe].mtx};
+            balance_ref(from) -= amount;
+            balance_ref(to) += amount;
+        }
+        else
+        {
+            std::scoped_lock lks{stripes_[from_stripe].mtx, stripes_[to_stripe].mtx};
+            balance_ref(from) -= amount;
+            balance_ref(to) += amount;
+        }
+    }
+
+    double balance(account_id id) const
+    {
+        assert(id < size_);
+
+        std::lock_guard lk{stripe_mutex(id)};
+        return balance_ref(id);
+    }
+
+    // consistent total - all stripes are locked (always in the same order)
+    double total() const
+    {
+        std::vector<std::unique_lock<std::mutex>> lks;
+        lks.reserve(stripes_.size());
+        for (auto& stripe : stripes_)
+            lks.emplace_back(stripe.mtx);
+
+        double sum = 0.0;
+        for (account_id id = 0; id < size_; ++id)
+            sum += balance_ref(id);
+
+        return sum;
+    }
+};
+
+#endif
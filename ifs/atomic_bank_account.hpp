@@ -0,0 +1,83 @@
+#ifndef ATOMIC_BANK_ACCOUNT_HPP
+#define ATOMIC_BANK_ACCOUNT_HPP
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+// Lock-free counterpart of BankAccount - the balance is kept as an atomic number of cents
+// Public API is the same as BankAccount, so make_withdraws/make_deposits work with both types
+class AtomicBankAccount
+{
+    const int id_;
+    std::atomic<std::int64_t> balance_in_cents_;
+
+    static std::int64_t to_cents(double amount)
+    {
+        return std::llround(amount * 100.0);
+    }
+
+    static double from_cents(std::int64_t cents)
+    {
+        return cents / 100.0;
+    }
+
+public:
+    AtomicBankAccount(int id, double balance)
+        : id_(id)
+        , balance_in_cents_(to_cents(balance))
+    {
+    }
+
+    void print() const
+    {
+        std::cout << "Bank Account #" << id_ << "; Balance = " << balance() << std::endl;
+    }
+
+    // withdraw and deposit are separate atomic steps - the money is "in flight" for a moment,
+    // but no operation is ever lost and the total is preserved once transfer returns
+    void transfer(AtomicBankAccount& to, double amount)
+    {
+        const auto cents = to_cents(amount);
+
+        balance_in_cents_.fetch_sub(cents, std::memory_order_relaxed);
+        to.balance_in_cents_.fetch_add(cents, std::memory_order_relaxed);
+    }
+
+    void withdraw(double amount)
+    {
+        balance_in_cents_.fetch_sub(to_cents(amount), std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool try_withdraw(double amount)
+    {
+        const auto cents = to_cents(amount);
+
+        auto current = balance_in_cents_.load(std::memory_order_relaxed);
+        while (current >= cents)
+        {
+            if (balance_in_cents_.compare_exchange_weak(current, current - cents, std::memory_order_relaxed))
+                return true;
+        }
+
+        return false;
+    }
+
+    void deposit(double amount)
+    {
+        balance_in_cents_.fetch_add(to_cents(amount), std::memory_order_relaxed);
+    }
+
+    int id() const
+    {
+        return id_;
+    }
+
+    double balance() const
+    {
+        return from_cents(balance_in_cents_.load(std::memory_order_relaxed));
+    }
+};
+
+#endif
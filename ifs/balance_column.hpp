@@ -0,0 +1,80 @@
+#ifndef BALANCE_COLUMN_HPP
+#define BALANCE_COLUMN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "money.hpp"
+
+struct EndOfDayPolicy
+{
+    Rate interest_rate;
+    Money fee;                  // charged when the balance after interest is below fee_waiver_threshold
+    Money fee_waiver_threshold;
+};
+
+// end-of-day processing of one account - the scalar path
+constexpr Money end_of_day(Money balance, const EndOfDayPolicy& policy)
+{
+    const auto with_interest = balance.cents() + apply_rate(balance.cents(), policy.interest_rate);
+    const auto fee = with_interest < policy.fee_waiver_threshold.cents() ? policy.fee.cents() : 0;
+    return Money::from_cents(with_interest - fee);
+}
+
+// Balances of many accounts stored as one contiguous column of cents
+// - end-of-day processing is one branch-free pass over the column - vectorized by the compiler
+//   (e.g. GCC -O3 -march=x86-64-v3: 4 balances per AVX2 instruction)
+// - every balance is computed exactly as by the scalar end_of_day()
+class BalanceColumn
+{
+    std::vector<std::int64_t> cents_;
+
+public:
+    BalanceColumn() = default;
+
+    explicit BalanceColumn(std::size_t size, Money initial_balance = Money{})
+        : cents_(size, initial_balance.cents())
+    {
+    }
+
+    std::size_t size() const
+    {
+        return cents_.size();
+    }
+
+    void push_back(Money balance)
+    {
+        cents_.push_back(balance.cents());
+    }
+
+    Money operator[](std::size_t index) const
+    {
+        return Money::from_cents(cents_[index]);
+    }
+
+    void set(std::size_t index, Money balance)
+    {
+        cents_[index] = balance.cents();
+    }
+
+    void apply_end_of_day(const EndOfDayPolicy& policy)
+    {
+        const EndOfDayPolicy local_policy = policy; // a copy cannot alias the column - allows vectorization
+        std::int64_t* const balances = cents_.data();
+        const std::size_t count = cents_.size();
+
+        for (std::size_t i = 0; i < count; ++i)
+            balances[i] = end_of_day(Money::from_cents(balances[i]), local_policy).cents();
+    }
+
+    Money total() const
+    {
+        std::int64_t sum = 0;
+        for (const auto cents : cents_)
+            sum += cents;
+        return Money::from_cents(sum);
+    }
+};
+
+#endif
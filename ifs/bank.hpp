@@ -0,0 +1,73 @@
+#ifndef BANK_HPP
+#define BANK_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "bank_account.hpp"
+#include "snapshot_epochs.hpp"
+
+struct BankSnapshot
+{
+    std::uint64_t epoch;
+    std::vector<std::pair<int, double>> balances; // (account id, balance)
+    double total;
+};
+
+// Registry of accounts with consistent whole-bank snapshots
+// - a snapshot does not lock all accounts at once - writers keep running
+//   (only writes started before the snapshot are waited for)
+// - every transfer is seen either on both sides or not at all
+// Accounts should be added before they are used by other threads
+class Bank
+{
+    SnapshotEpochs epochs_;
+    mutable std::mutex mtx_accounts_;
+    std::vector<BankAccount*> accounts_;
+
+public:
+    Bank() = default;
+    Bank(const Bank&) = delete;
+    Bank& operator=(const Bank&) = delete;
+
+    void add(BankAccount& account)
+    {
+        std::lock_guard lk{mtx_accounts_};
+        account.snapshot_epochs_ = &epochs_;
+        accounts_.push_back(&account);
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard lk{mtx_accounts_};
+        return accounts_.size();
+    }
+
+    BankSnapshot snapshot()
+    {
+        std::lock_guard lk{mtx_accounts_};
+
+        return epochs_.snapshot([this](std::uint64_t epoch) {
+            BankSnapshot result{epoch, {}, 0.0};
+            result.balances.reserve(accounts_.size());
+
+            for (BankAccount* account : accounts_)
+            {
+                const double balance = account->snapshot_balance(epoch);
+                result.balances.emplace_back(account->id(), balance);
+                result.total += balance;
+            }
+
+            return result;
+        });
+    }
+
+    double total()
+    {
+        return snapshot().total;
+    }
+};
+
+#endif
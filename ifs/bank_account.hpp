@@ -0,0 +1,236 @@
+#ifndef BANK_ACCOUNT_HPP
+#define BANK_ACCOUNT_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+
+#include "instrumented_mutex.hpp"
+#include "snapshot_epochs.hpp"
+
+enum class Operation : std::int32_t
+{
+    open = 1,
+    deposit,
+    withdraw,
+    transfer
+};
+
+// receives every balance change of the attached accounts - see TransactionJournal
+class TransactionLog
+{
+public:
+    virtual void append(Operation op, int account_id, double amount, int to_account_id = 0) = 0;
+    virtual ~TransactionLog() = default;
+};
+
+class BankAccount
+{
+    const int id_;
+    std::atomic<double> balance_; // written only with mtx_balance_ locked - read lock-free
+    mutable InstrumentedMutex mtx_balance_;
+    TransactionLog* log_ = nullptr;
+    SnapshotEpochs* snapshot_epochs_ = nullptr;
+    std::uint64_t delta_epoch_ = 0; // guarded by mtx_balance_
+    double delta_ = 0.0;            // sum of changes made by writers of delta_epoch_
+
+    friend class Bank;
+
+    SnapshotEpochs::WriterPin pin_snapshot_epoch()
+    {
+        return SnapshotEpochs::WriterPin{snapshot_epochs_};
+    }
+
+    // must be called with mtx_balance_ locked
+    // - writers of an older epoch may still run when the first writer of a new epoch arrives,
+    //   so the changes of the newest epoch are tracked as a delta (not as a pre-image)
+    void track_delta(double amount, std::uint64_t epoch)
+    {
+        if (epoch == 0 || epoch < delta_epoch_)
+            return;
+
+        if (epoch > delta_epoch_)
+        {
+            delta_epoch_ = epoch;
+            delta_ = 0.0;
+        }
+
+        delta_ += amount;
+    }
+
+    // balance as seen by the snapshot of the given epoch - changes made in this epoch are excluded
+    double snapshot_balance(std::uint64_t epoch) const
+    {
+        std::lock_guard lk{mtx_balance_};
+        const double balance = balance_.load(std::memory_order_relaxed);
+        return delta_epoch_ == epoch ? balance - delta_ : balance;
+    }
+
+    // must be called with mtx_balance_ locked
+    void add_to_balance(double amount, std::uint64_t snapshot_epoch)
+    {
+        track_delta(amount, snapshot_epoch);
+
+        balance_.store(balance_.load(std::memory_order_relaxed) + amount, std::memory_order_release);
+    }
+
+    // must be called with mtx_balance_ locked, before the balance is changed
+    // - the log sees changes of an account in order and a failing log leaves the balance intact
+    void log(Operation op, double amount, int to_account_id = 0)
+    {
+        if (log_)
+            log_->append(op, id_, amount, to_account_id);
+    }
+
+public:
+    BankAccount(int id, double balance)
+        : id_(id)
+        , balance_(balance)
+    {
+    }
+
+    // transfers are logged by the source account
+    void attach_log(TransactionLog& transaction_log)
+    {
+        std::lock_guard lk{mtx_balance_};
+        log_ = &transaction_log;
+        log(Operation::open, balance_.load(std::memory_order_relaxed));
+    }
+
+    void print() const
+    {
+        std::cout << "Bank Account #" << id_ << "; Balance = " << balance() << std::endl;
+    }
+
+    void transfer(BankAccount& to, double amount)
+    {
+        // std::unique_lock lk_from{mtx_balance_, std::defer_lock};
+        // std::unique_lock lk_to{to.mtx_balance_, std::defer_lock};
+
+        // std::lock(lk_from, lk_to); // deadlock-free lock
+
+        const auto epoch_pin = pin_snapshot_epoch();
+
+        // since C++17
+        std::scoped_lock lks{mtx_balance_, to.mtx_balance_};
+
+        log(Operation::transfer, amount, to.id_);
+        add_to_balance(-amount, epoch_pin.epoch());
+        to.add_to_balance(amount, epoch_pin.epoch());
+    }
+
+    // locks are always taken in the same global order (by id) - no try & back-off retries
+    void transfer_ordered(BankAccount& to, double amount)
+    {
+        assert(this != &to);
+
+        const auto epoch_pin = pin_snapshot_epoch();
+
+        const bool this_first = id_ != to.id_ ? id_ < to.id_ : std::less<>{}(this, &to);
+        auto& first = this_first ? mtx_balance_ : to.mtx_balance_;
+        auto& second = this_first ? to.mtx_balance_ : mtx_balance_;
+
+        std::lock_guard lk_first{first};
+        std::lock_guard lk_second{second};
+
+        log(Operation::transfer, amount, to.id_);
+        add_to_balance(-amount, epoch_pin.epoch());
+        to.add_to_balance(amount, epoch_pin.epoch());
+    }
+
+    void withdraw(double amount)
+    {
+        const auto epoch_pin = pin_snapshot_epoch();
+
+        std::lock_guard lk{mtx_balance_};
+        log(Operation::withdraw, amount);
+        add_to_balance(-amount, epoch_pin.epoch());
+    }
+
+    [[nodiscard]] bool try_withdraw(double amount)
+    {
+        const auto epoch_pin = pin_snapshot_epoch();
+
+        if (std::lock_guard lk{mtx_balance_}; balance_.load(std::memory_order_relaxed) >= amount)
+        {
+            log(Operation::withdraw, amount);
+            add_to_balance(-amount, epoch_pin.epoch());
+            return true;
+        }
+
+        return false;
+    }
+
+    void deposit(double amount)
+    {
+        const auto epoch_pin = pin_snapshot_epoch();
+
+        std::scoped_lock lk{mtx_balance_};
+        log(Operation::deposit, amount);
+        add_to_balance(amount, epoch_pin.epoch());
+    }
+
+    int id() const
+    {
+        return id_;
+    }
+
+    // lock-free read - never blocks writers
+    double balance() const
+    {
+        return balance_.load(std::memory_order_acquire);
+    }
+
+    double balance_locked() const
+    {
+        std::lock_guard lk{mtx_balance_};
+        return balance_.load(std::memory_order_relaxed);
+    }
+
+    LockStats lock_stats() const
+    {
+        return mtx_balance_.stats();
+    }
+
+    void reset_lock_stats()
+    {
+        mtx_balance_.reset_stats();
+    }
+};
+
+template <typename TAccount>
+void make_withdraws(TAccount& ba, int no_of_operations)
+{
+    for (int i = 0; i < no_of_operations; ++i)
+        ba.withdraw(1.0);
+}
+
+template <typename TAccount>
+void make_deposits(TAccount& ba, int no_of_operations)
+{
+    for (int i = 0; i < no_of_operations; ++i)
+        ba.deposit(1.0);
+}
+
+template <typename TAccount>
+void make_transfers(TAccount& from, TAccount& to, int no_of_operations, [[maybe_unused]] int thd_id)
+{
+    for (int i = 0; i < no_of_operations; ++i)
+    {
+        from.transfer(to, 1.0);
+    }
+}
+
+template <typename TAccount>
+void make_ordered_transfers(TAccount& from, TAccount& to, int no_of_operations, [[maybe_unused]] int thd_id)
+{
+    for (int i = 0; i < no_of_operations; ++i)
+    {
+        from.transfer_ordered(to, 1.0);
+    }
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef BLOCKING_QUEUE_HPP
+#define BLOCKING_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+// Unbounded blocking queue with adaptive waiting
+// - a consumer of an empty queue first spins for a short while (cheap, low wake-up latency)
+//   and then parks on a condition variable (no CPU use while idle)
+// - producers notify only when some consumer is parked
+// - close() wakes all consumers; items pushed before close() can still be popped
+template <typename T>
+class BlockingQueue
+{
+    std::deque<T> q_;
+    std::mutex mtx_q_;
+    std::condition_variable cv_not_empty_;
+    int no_of_parked_ = 0; // guarded by mtx_q_
+
+    std::atomic<std::size_t> size_{0}; // read without lock while spinning
+    std::atomic<bool> closed_{false};  // written with mtx_q_ locked, read without lock while spinning
+    const int spin_count_;
+
+    static void cpu_relax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    // must be called with mtx_q_ locked and q_ not empty
+    T pop_front_locked()
+    {
+        T item = std::move(q_.front());
+        q_.pop_front();
+        size_.store(q_.size(), std::memory_order_relaxed);
+        return item;
+    }
+
+    // only a hint - the state is checked again with mtx_q_ locked
+    void spin_while_empty() const
+    {
+        for (int i = 0; i < spin_count_; ++i)
+        {
+            if (size_.load(std::memory_order_relaxed) != 0 || closed_.load(std::memory_order_relaxed))
+                return;
+            cpu_relax();
+        }
+    }
+
+    template <typename TWait>
+    std::optional<T> pop_with(TWait wait)
+    {
+        spin_while_empty();
+
+        std::unique_lock lk{mtx_q_};
+
+        if (q_.empty() && !is_closed())
+        {
+            ++no_of_parked_;
+            wait(lk, [this] { return !q_.empty() || is_closed(); });
+            --no_of_parked_;
+        }
+
+        if (q_.empty())
+            return std::nullopt;
+
+        return pop_front_locked();
+    }
+
+public:
+    explicit BlockingQueue(int spin_count = 4'000)
+        : spin_count_{spin_count}
+    {
+    }
+
+    BlockingQueue(const BlockingQueue&) = delete;
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+    // returns false if the queue is closed
+    template <typename TItem>
+    bool push(TItem&& item)
+    {
+        bool notify;
+
+        {
+            std::lock_guard lk{mtx_q_};
+
+            if (is_closed())
+                return false;
+
+            q_.push_back(std::forward<TItem>(item));
+            size_.store(q_.size(), std::memory_order_relaxed);
+            notify = no_of_parked_ > 0;
+        }
+
+        if (notify)
+            cv_not_empty_.notify_one();
+
+        return true;
+    }
+
+    std::optional<T> try_pop()
+    {
+        if (std::lock_guard lk{mtx_q_}; !q_.empty())
+            return pop_front_locked();
+
+        return std::nullopt;
+    }
+
+    // blocks until an item is available; std::nullopt - queue is closed and empty
+    std::optional<T> pop()
+    {
+        return pop_with([this](auto& lk, auto pred) { cv_not_empty_.wait(lk, pred); });
+    }
+
+    // std::nullopt - timeout or queue is closed and empty
+    template <typename TRep, typename TPeriod>
+    std::optional<T> pop_for(const std::chrono::duration<TRep, TPeriod>& timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return pop_with([this, deadline](auto& lk, auto pred) { cv_not_empty_.wait_until(lk, deadline, pred); });
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard lk{mtx_q_};
+            closed_.store(true, std::memory_order_relaxed);
+        }
+
+        cv_not_empty_.notify_all();
+    }
+
+    bool is_closed() const
+    {
+        return closed_.load(std::memory_order_relaxed);
+    }
+};
+
+#endif
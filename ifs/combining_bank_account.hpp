@@ -0,0 +1,156 @@
+#ifndef COMBINING_BANK_ACCOUNT_HPP
+#define COMBINING_BANK_ACCOUNT_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "cache_line.hpp"
+
+// Bank account for hot accounts updated by many threads (flat combining)
+// - a thread publishes its deposit/withdraw in its own slot and tries to become the combiner
+// - the combiner applies all pending operations in one batch under one lock acquisition
+// - an operation is applied before deposit/withdraw returns, so balance() is always exact
+// Public API is the same as BankAccount, so make_withdraws/make_deposits work with all types
+class CombiningBankAccount
+{
+    static constexpr std::size_t max_publishers = 64;
+
+    enum SlotState : int
+    {
+        slot_free,
+        slot_claimed,
+        slot_pending,
+        slot_done
+    };
+
+    struct alignas(cache_line_size) PublicationSlot
+    {
+        std::atomic<int> state{slot_free};
+        double amount = 0.0;
+    };
+
+    const int id_;
+    std::atomic<double> balance_; // written only by the combiner
+    std::mutex mtx_combiner_;
+    PublicationSlot slots_[max_publishers];
+
+    static std::size_t thread_slot_index()
+    {
+        static std::atomic<std::size_t> next_index{0};
+        thread_local const std::size_t index = next_index++ % max_publishers;
+        return index;
+    }
+
+    // must be called with mtx_combiner_ locked
+    void combine()
+    {
+        bool applied[max_publishers] = {};
+        double balance = balance_.load(std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < max_publishers; ++i)
+        {
+            if (slots_[i].state.load(std::memory_order_acquire) == slot_pending)
+            {
+                balance += slots_[i].amount;
+                applied[i] = true;
+            }
+        }
+
+        balance_.store(balance, std::memory_order_release);
+
+        // publishers are released only after the new balance is visible
+        for (std::size_t i = 0; i < max_publishers; ++i)
+        {
+            if (applied[i])
+                slots_[i].state.store(slot_done, std::memory_order_release);
+        }
+    }
+
+    void apply(double amount)
+    {
+        auto& slot = slots_[thread_slot_index()];
+
+        if (int expected = slot_free; !slot.state.compare_exchange_strong(expected, slot_claimed, std::memory_order_acquire))
+        {
+            // slot is shared with another thread - apply directly
+            std::lock_guard lk{mtx_combiner_};
+            combine();
+            balance_.store(balance_.load(std::memory_order_relaxed) + amount, std::memory_order_release);
+            return;
+        }
+
+        slot.amount = amount;
+        slot.state.store(slot_pending, std::memory_order_release);
+
+        while (slot.state.load(std::memory_order_acquire) != slot_done)
+        {
+            if (std::unique_lock lk{mtx_combiner_, std::try_to_lock}; lk.owns_lock())
+                combine();
+            else
+                std::this_thread::yield();
+        }
+
+        slot.state.store(slot_free, std::memory_order_release);
+    }
+
+public:
+    CombiningBankAccount(int id, double balance)
+        : id_(id)
+        , balance_(balance)
+    {
+    }
+
+    CombiningBankAccount(const CombiningBankAccount&) = delete;
+    CombiningBankAccount& operator=(const CombiningBankAccount&) = delete;
+
+    void print() const
+    {
+        std::cout << "Bank Account #" << id_ << "; Balance = " << balance() << std::endl;
+    }
+
+    // withdraw and deposit are separate steps - the money is "in flight" for a moment
+    void transfer(CombiningBankAccount& to, double amount)
+    {
+        withdraw(amount);
+        to.deposit(amount);
+    }
+
+    void withdraw(double amount)
+    {
+        apply(-amount);
+    }
+
+    // bounds check needs the current balance - done directly by the combiner
+    [[nodiscard]] bool try_withdraw(double amount)
+    {
+        std::lock_guard lk{mtx_combiner_};
+        combine();
+
+        const double balance = balance_.load(std::memory_order_relaxed);
+        if (balance < amount)
+            return false;
+
+        balance_.store(balance - amount, std::memory_order_release);
+        return true;
+    }
+
+    void deposit(double amount)
+    {
+        apply(amount);
+    }
+
+    int id() const
+    {
+        return id_;
+    }
+
+    double balance() const
+    {
+        return balance_.load(std::memory_order_acquire);
+    }
+};
+
+#endif
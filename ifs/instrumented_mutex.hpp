@@ -0,0 +1,70 @@
+#ifndef INSTRUMENTED_MUTEX_HPP
+#define INSTRUMENTED_MUTEX_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+struct LockStats
+{
+    std::uint64_t waits;   // lock() calls that had to block
+    std::uint64_t retries; // failed try_lock() calls - e.g. back-offs of std::lock/std::scoped_lock
+    std::chrono::nanoseconds wait_time;
+};
+
+// std::mutex with contention counters - meets Lockable requirements,
+// so it works with std::lock_guard, std::unique_lock & std::scoped_lock
+// Counters are touched only on the contended path
+class InstrumentedMutex
+{
+    std::mutex mtx_;
+    std::atomic<std::uint64_t> waits_{0};
+    std::atomic<std::uint64_t> retries_{0};
+    std::atomic<std::int64_t> wait_time_ns_{0};
+
+public:
+    void lock()
+    {
+        if (mtx_.try_lock())
+            return;
+
+        waits_.fetch_add(1, std::memory_order_relaxed);
+
+        const auto start = std::chrono::steady_clock::now();
+        mtx_.lock();
+        const auto wait_time = std::chrono::steady_clock::now() - start;
+
+        wait_time_ns_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(wait_time).count(), std::memory_order_relaxed);
+    }
+
+    bool try_lock()
+    {
+        if (mtx_.try_lock())
+            return true;
+
+        retries_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void unlock()
+    {
+        mtx_.unlock();
+    }
+
+    LockStats stats() const
+    {
+        return LockStats{waits_.load(std::memory_order_relaxed),
+            retries_.load(std::memory_order_relaxed),
+            std::chrono::nanoseconds{wait_time_ns_.load(std::memory_order_relaxed)}};
+    }
+
+    void reset_stats()
+    {
+        waits_.store(0, std::memory_order_relaxed);
+        retries_.store(0, std::memory_order_relaxed);
+        wait_time_ns_.store(0, std::memory_order_relaxed);
+    }
+};
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef MESSAGE_CHANNEL_HPP
+#define MESSAGE_CHANNEL_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "cache_line.hpp"
+
+// Single-producer/single-consumer channel of byte messages stored in a preallocated ring (arena)
+// - try_send copies the payload into the ring - no heap allocation per message
+// - try_receive returns a view of the payload stored in the ring (zero-copy)
+// - the storage is recycled when the consumer acknowledges the message;
+//   acknowledging a message acknowledges all messages received before it
+// - a payload may take at most half of the ring (max_payload_size()) - a record that does not fit before
+//   the end of the ring wastes the rest of it, and only with this limit does every record fit into an empty ring
+class MessageChannel
+{
+    using header_type = std::uint32_t;
+
+    static constexpr header_type wrap_marker = UINT32_MAX; // rest of the ring is unused - continue at its start
+
+    const std::size_t capacity_;
+    std::unique_ptr<char[]> ring_;
+
+    alignas(cache_line_size) std::atomic<std::size_t> write_pos_{0};
+    alignas(cache_line_size) std::atomic<std::size_t> release_pos_{0};
+    alignas(cache_line_size) std::size_t read_pos_ = 0; // used only by consumer
+
+    static std::size_t round_up_to_power_of_2(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value)
+            result *= 2;
+        return result;
+    }
+
+    static std::size_t record_size(std::size_t payload_size)
+    {
+        const auto size = sizeof(header_type) + payload_size;
+        return (size + sizeof(header_type) - 1) / sizeof(header_type) * sizeof(header_type);
+    }
+
+    std::size_t offset(std::size_t pos) const
+    {
+        return pos & (capacity_ - 1);
+    }
+
+public:
+    class Message
+    {
+        std::string_view payload_;
+        std::size_t end_pos_;
+
+        friend class MessageChannel;
+
+        Message(std::string_view payload, std::size_t end_pos)
+            : payload_{payload}
+            , end_pos_{end_pos}
+        {
+        }
+
+    public:
+        // valid until the message is acknowledged
+        std::string_view payload() const
+        {
+            return payload_;
+        }
+    };
+
+    explicit MessageChannel(std::size_t capacity_in_bytes)
+        : capacity_{round_up_to_power_of_2(capacity_in_bytes < 64 ? 64 : capacity_in_bytes)}
+        , ring_{new char[capacity_]}
+    {
+    }
+
+    MessageChannel(const MessageChannel&) = delete;
+    MessageChannel& operator=(const MessageChannel&) = delete;
+
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    std::size_t max_payload_size() const
+    {
+        return capacity_ / 2 - sizeof(header_type);
+    }
+
+    // producer side - false if there is not enough free space (or the payload is larger than max_payload_size())
+    [[nodiscard]] bool try_send(std::string_view payload)
+    {
+        if (payload.size() > max_payload_size() || payload.size() >= wrap_marker)
+            return false;
+
+        const auto size = record_size(payload.size());
+        const auto pos = write_pos_.load(std::memory_order_relaxed);
+        const auto bytes_to_end = capacity_ - offset(pos);
+        const auto skip = size > bytes_to_end ? bytes_to_end : 0; // payload must be contiguous
+
+        if (pos + skip + size - release_pos_.load(std::memory_order_acquire) > capacity_)
+            return false;
+
+        if (skip != 0)
+        {
+            const header_type marker = wrap_marker;
+            std::memcpy(&ring_[offset(pos)], &marker, sizeof(marker));
+        }
+
+        const auto record_pos = pos + skip;
+        const auto length = static_cast<header_type>(payload.size());
+        std::memcpy(&ring_[offset(record_pos)], &length, sizeof(length));
+        std::memcpy(&ring_[offset(record_pos) + sizeof(header_type)], payload.data(), payload.size());
+
+        write_pos_.store(record_pos + size, std::memory_order_release);
+
+        return true;
+    }
+
+    // consumer side
+    [[nodiscard]] std::optional<Message> try_receive()
+    {
+        const auto write_pos = write_pos_.load(std::memory_order_acquire);
+
+        if (read_pos_ == write_pos)
+            return std::nullopt;
+
+        header_type length;
+        std::memcpy(&length, &ring_[offset(read_pos_)], sizeof(length));
+
+        if (length == wrap_marker)
+        {
+            read_pos_ += capacity_ - offset(read_pos_);
+            std::memcpy(&length, &ring_[offset(read_pos_)], sizeof(length));
+        }
+
+        const std::string_view payload{&ring_[offset(read_pos_) + sizeof(header_type)], length};
+        read_pos_ += record_size(length);
+
+        return Message{payload, read_pos_};
+    }
+
+    // consumer side - releases storage of msg and of all messages received before it
+    void acknowledge(const Message& msg)
+    {
+        assert(msg.end_pos_ <= read_pos_);
+        release_pos_.store(msg.end_pos_, std::memory_order_release);
+    }
+};
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef MONEY_HPP
+#define MONEY_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+// 64-bit fixed-point amount of money (in cents) - exact under any number of additions
+class Money
+{
+    std::int64_t cents_ = 0;
+
+public:
+    constexpr Money() = default;
+
+    constexpr static Money from_cents(std::int64_t cents)
+    {
+        Money result;
+        result.cents_ = cents;
+        return result;
+    }
+
+    static Money from_double(double amount)
+    {
+        return from_cents(std::llround(amount * 100.0));
+    }
+
+    constexpr std::int64_t cents() const
+    {
+        return cents_;
+    }
+
+    constexpr double to_double() const
+    {
+        return cents_ / 100.0;
+    }
+
+    constexpr Money& operator+=(Money other)
+    {
+        cents_ += other.cents_;
+        return *this;
+    }
+
+    constexpr Money& operator-=(Money other)
+    {
+        cents_ -= other.cents_;
+        return *this;
+    }
+
+    constexpr Money operator-() const
+    {
+        return from_cents(-cents_);
+    }
+
+    friend constexpr Money operator+(Money a, Money b)
+    {
+        return a += b;
+    }
+
+    friend constexpr Money operator-(Money a, Money b)
+    {
+        return a -= b;
+    }
+
+    friend constexpr bool operator==(Money a, Money b)
+    {
+        return a.cents_ == b.cents_;
+    }
+
+    friend constexpr bool operator!=(Money a, Money b)
+    {
+        return !(a == b);
+    }
+
+    friend constexpr bool operator<(Money a, Money b)
+    {
+        return a.cents_ < b.cents_;
+    }
+
+    friend constexpr bool operator>(Money a, Money b)
+    {
+        return b < a;
+    }
+
+    friend constexpr bool operator<=(Money a, Money b)
+    {
+        return !(b < a);
+    }
+
+    friend constexpr bool operator>=(Money a, Money b)
+    {
+        return !(a < b);
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, Money money)
+    {
+        const auto abs_cents = money.cents_ < 0 ? -money.cents_ : money.cents_;
+        const auto fraction = abs_cents % 100;
+        return out << (money.cents_ < 0 ? "-" : "") << abs_cents / 100 << "." << (fraction < 10 ? "0" : "") << fraction;
+    }
+};
+
+namespace MoneyLiterals
+{
+    constexpr Money operator""_cents(unsigned long long cents)
+    {
+        return Money::from_cents(static_cast<std::int64_t>(cents));
+    }
+}
+
+// decimal fixed-point rate in units of 1e-9 - decimal rates (0.05, 0.0001) are exact,
+// a rate from a double (e.g. 0.05 / 365) is off by at most 0.5e-9
+// - rates up to +/-9.2 (920%) can be applied to any balance whose result fits in 63 bits
+class Rate
+{
+    std::int64_t nanos_ = 0;
+
+public:
+    static constexpr std::int64_t scale = 1'000'000'000;
+
+    constexpr Rate() = default;
+
+    constexpr static Rate from_nanos(std::int64_t nanos)
+    {
+        Rate result;
+        result.nanos_ = nanos;
+        return result;
+    }
+
+    static Rate from_double(double rate)
+    {
+        return from_nanos(std::llround(rate * static_cast<double>(scale)));
+    }
+
+    constexpr std::int64_t nanos() const
+    {
+        return nanos_;
+    }
+};
+
+namespace Detail
+{
+    // high 64 bits of a * b built from 32 x 32 -> 64 bit products - vector units have those (unlike a 64-bit divide)
+    constexpr std::uint64_t mul_high(std::uint64_t a, std::uint64_t b)
+    {
+        constexpr std::uint64_t low_mask = 0xFFFF'FFFF;
+
+        const std::uint64_t low_low = (a & low_mask) * (b & low_mask);
+        const std::uint64_t low_high = (a & low_mask) * (b >> 32);
+        const std::uint64_t high_low = (a >> 32) * (b & low_mask);
+        const std::uint64_t high_high = (a >> 32) * (b >> 32);
+
+        const std::uint64_t middle = (low_low >> 32) + (low_high & low_mask) + (high_low & low_mask);
+        return high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+    }
+
+    // value / Rate::scale - multiply by the reciprocal (floor(2^64 / scale)) & correct the estimate
+    // (it is never more than 1 too small)
+    constexpr std::uint64_t divide_by_rate_scale(std::uint64_t value)
+    {
+        constexpr std::uint64_t scale = Rate::scale;
+        constexpr std::uint64_t reciprocal = ~std::uint64_t{0} / scale;
+
+        const std::uint64_t quotient = mul_high(value, reciprocal);
+        const std::uint64_t remainder = value - quotient * scale;
+        return quotient + (remainder >= scale ? 1 : 0);
+    }
+}
+
+// cents * rate rounded half away from zero - exact integer arithmetic without branches & divide instructions,
+// so a loop over many balances vectorizes (e.g. -O3 -march=x86-64-v3)
+// - cents are split at the scale, so no intermediate product is larger than the result or 2^63
+// this is the only rounding used by scalar and batch paths
+constexpr std::int64_t apply_rate(std::int64_t cents, Rate rate)
+{
+    constexpr std::uint64_t scale = Rate::scale;
+
+    const std::int64_t cents_sign = cents < 0 ? -1 : 0;
+    const std::int64_t rate_sign = rate.nanos() < 0 ? -1 : 0;
+    const std::int64_t sign = cents_sign ^ rate_sign;
+    const auto abs_cents = static_cast<std::uint64_t>((cents ^ cents_sign) - cents_sign);
+    const auto abs_nanos = static_cast<std::uint64_t>((rate.nanos() ^ rate_sign) - rate_sign);
+
+    const std::uint64_t high = Detail::divide_by_rate_scale(abs_cents);
+    const std::uint64_t low = abs_cents - high * scale;
+    const auto rounded = static_cast<std::int64_t>(high * abs_nanos + Detail::divide_by_rate_scale(low * abs_nanos + scale / 2));
+    return (rounded ^ sign) - sign;
+}
+
+constexpr Money operator*(Money money, Rate rate)
+{
+    return Money::from_cents(apply_rate(money.cents(), rate));
+}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "cache_line.hpp"
+
+// Bounded lock-free multi-producer/multi-consumer queue (ring buffer with per-cell sequence numbers)
+// - try_push/try_pop never block - they fail when the queue is full/empty
+// - capacity is rounded up to a power of two
+// - a claimed cell must always be published - items are moved in & out with noexcept moves only
+//   (an item whose construction may throw is built before a cell is claimed)
+template <typename T>
+class BoundedMpmcQueue
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>, "BoundedMpmcQueue requires a nothrow move constructible T");
+
+    struct alignas(cache_line_size) Cell
+    {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* item()
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    const std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(cache_line_size) std::atomic<std::size_t> push_pos_{0};
+    alignas(cache_line_size) std::atomic<std::size_t> pop_pos_{0};
+
+    static std::size_t round_up_to_power_of_2(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value)
+            result *= 2;
+        return result;
+    }
+
+    // item must be constructible without throwing
+    template <typename TItem>
+    bool try_push_nothrow(TItem&& item) noexcept
+    {
+        auto pos = push_pos_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Cell& cell = cells_[pos & mask_];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+            if (diff == 0)
+            {
+                if (push_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    new (cell.storage) T(std::forward<TItem>(item));
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                pos = push_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    explicit BoundedMpmcQueue(std::size_t capacity)
+        : mask_{round_up_to_power_of_2(capacity < 2 ? 2 : capacity) - 1}
+        , cells_{new Cell[mask_ + 1]}
+    {
+        for (std::size_t i = 0; i <= mask_; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+    BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+    ~BoundedMpmcQueue()
+    {
+        while (try_pop())
+            ;
+    }
+
+    std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    template <typename TItem>
+    [[nodiscard]] bool try_push(TItem&& item)
+    {
+        if constexpr (std::is_nothrow_constructible_v<T, TItem&&>)
+            return try_push_nothrow(std::forward<TItem>(item));
+        else
+            return try_push_nothrow(T(std::forward<TItem>(item))); // may throw - nothing is claimed yet
+    }
+
+    [[nodiscard]] std::optional<T> try_pop()
+    {
+        auto pos = pop_pos_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Cell& cell = cells_[pos & mask_];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+
+            if (diff == 0)
+            {
+                if (pop_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    std::optional<T> result{std::move(*cell.item())};
+                    cell.item()->~T();
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return result;
+                }
+            }
+            else if (diff < 0)
+            {
+                return std::nullopt; // empty
+            }
+            else
+            {
+                pos = pop_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef SNAPSHOT_EPOCHS_HPP
+#define SNAPSHOT_EPOCHS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "cache_line.hpp"
+
+// Epochs for consistent snapshots of many objects while writers keep running
+// - every write operation pins the current epoch for its whole duration
+// - a snapshot starts a new epoch and waits only for writes pinned to the previous one
+// - objects keep track of changes made in the new epoch, so the snapshot can exclude them
+//   and see every object as it was at the moment the epoch changed
+// - writer counters are striped by thread - concurrent writers do not update the same cache line
+class SnapshotEpochs
+{
+    struct alignas(cache_line_size) WriterCounter
+    {
+        std::atomic<std::int64_t> value{0};
+    };
+
+    static constexpr std::size_t no_of_stripes = 16;
+
+    std::atomic<std::uint64_t> epoch_{1};
+    WriterCounter active_writers_[no_of_stripes][2];
+    std::mutex mtx_snapshot_;
+
+    static std::size_t stripe_of_this_thread()
+    {
+        static std::atomic<std::size_t> next_stripe{0};
+        thread_local const std::size_t stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % no_of_stripes;
+        return stripe;
+    }
+
+    WriterCounter& writers_of(std::size_t stripe, std::uint64_t epoch)
+    {
+        return active_writers_[stripe][epoch % 2];
+    }
+
+public:
+    class WriterPin
+    {
+        SnapshotEpochs* epochs_;
+        std::uint64_t epoch_;
+        std::size_t stripe_;
+
+    public:
+        explicit WriterPin(SnapshotEpochs* epochs)
+            : epochs_{epochs}
+            , epoch_{0}
+            , stripe_{0}
+        {
+            if (!epochs_)
+                return;
+
+            stripe_ = stripe_of_this_thread();
+
+            while (true)
+            {
+                epoch_ = epochs_->epoch_.load();
+                epochs_->writers_of(stripe_, epoch_).value.fetch_add(1);
+
+                if (epochs_->epoch_.load() == epoch_)
+                    return;
+
+                epochs_->writers_of(stripe_, epoch_).value.fetch_sub(1); // snapshot started in the meantime
+            }
+        }
+
+        WriterPin(const WriterPin&) = delete;
+        WriterPin& operator=(const WriterPin&) = delete;
+
+        ~WriterPin()
+        {
+            if (epochs_)
+                epochs_->writers_of(stripe_, epoch_).value.fetch_sub(1, std::memory_order_release);
+        }
+
+        // 0 - write is not a part of any snapshot scheme
+        std::uint64_t epoch() const
+        {
+            return epoch_;
+        }
+    };
+
+    // starts a new epoch and calls read_all(epoch) once all writes of the previous epoch are done
+    template <typename TReadAll>
+    decltype(auto) snapshot(TReadAll read_all)
+    {
+        std::lock_guard lk{mtx_snapshot_};
+
+        const auto prev_epoch = epoch_.fetch_add(1);
+
+        // a stripe seen empty stays empty - later writers see the new epoch & move to it
+        for (std::size_t stripe = 0; stripe < no_of_stripes; ++stripe)
+        {
+            while (writers_of(stripe, prev_epoch).value.load() != 0)
+                std::this_thread::yield();
+        }
+
+        return read_all(prev_epoch + 1);
+    }
+};
+
+#endif
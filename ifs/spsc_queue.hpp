@@ -0,0 +1,123 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "cache_line.hpp"
+
+// Wait-free bounded single-producer/single-consumer queue
+// - each side keeps a cached copy of the other side's position and re-reads it only when needed
+// - drain() consumes many items but publishes its position once - one cache-line transfer per batch
+template <typename T>
+class SpscQueue
+{
+    struct Slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* item()
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    const std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    alignas(cache_line_size) std::atomic<std::size_t> push_pos_{0};
+    std::size_t cached_pop_pos_ = 0; // used only by producer
+
+    alignas(cache_line_size) std::atomic<std::size_t> pop_pos_{0};
+    std::size_t cached_push_pos_ = 0; // used only by consumer
+
+    static std::size_t round_up_to_power_of_2(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value)
+            result *= 2;
+        return result;
+    }
+
+public:
+    explicit SpscQueue(std::size_t capacity)
+        : mask_{round_up_to_power_of_2(capacity < 2 ? 2 : capacity) - 1}
+        , slots_{new Slot[mask_ + 1]}
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue()
+    {
+        drain(capacity(), [](T&&) {});
+    }
+
+    std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    // producer side
+    template <typename TItem>
+    [[nodiscard]] bool try_push(TItem&& item)
+    {
+        const auto pos = push_pos_.load(std::memory_order_relaxed);
+
+        if (pos - cached_pop_pos_ > mask_)
+        {
+            cached_pop_pos_ = pop_pos_.load(std::memory_order_acquire);
+            if (pos - cached_pop_pos_ > mask_)
+                return false; // full
+        }
+
+        new (slots_[pos & mask_].storage) T(std::forward<TItem>(item));
+        push_pos_.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // consumer side
+    [[nodiscard]] std::optional<T> try_pop()
+    {
+        std::optional<T> result;
+        drain(1, [&result](T&& item) { result.emplace(std::move(item)); });
+        return result;
+    }
+
+    // consumer side - passes up to max_n items (as rvalues) to callback; returns number of consumed items
+    // callback must not throw
+    template <typename TCallback>
+    std::size_t drain(std::size_t max_n, TCallback&& callback)
+    {
+        const auto pos = pop_pos_.load(std::memory_order_relaxed);
+
+        if (cached_push_pos_ == pos)
+        {
+            cached_push_pos_ = push_pos_.load(std::memory_order_acquire);
+            if (cached_push_pos_ == pos)
+                return 0; // empty
+        }
+
+        const auto count = std::min(max_n, cached_push_pos_ - pos);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            T* item = slots_[(pos + i) & mask_].item();
+            callback(std::move(*item));
+            item->~T();
+        }
+
+        pop_pos_.store(pos + count, std::memory_order_release);
+
+        return count;
+    }
+};
+
+#endif
@@ -0,0 +1,944 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "account_ledger.hpp"
+#include "balance_column.hpp"
+#include "bank.hpp"
+#include "atomic_bank_account.hpp"
+#include "bank_account.hpp"
+#include "combining_bank_account.hpp"
+#include "instrumented_mutex.hpp"
+#include "money.hpp"
+#include "transfer_batch.hpp"
+
+#if __has_include(<sys/mman.h>)
+#include "transaction_journal.hpp"
+#endif
+
+using namespace std;
+
+namespace
+{
+    // even threads withdraw, odd threads deposit
+    template <typename TAccount>
+    void run_withdraws_and_deposits(TAccount& account, int no_of_threads, int no_of_operations)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(no_of_threads);
+
+        for (int i = 0; i < no_of_threads; ++i)
+        {
+            if (i % 2 == 0)
+                threads.emplace_back(&make_withdraws<TAccount>, std::ref(account), no_of_operations);
+            else
+                threads.emplace_back(&make_deposits<TAccount>, std::ref(account), no_of_operations);
+        }
+
+        for (auto& thd : threads)
+            thd.join();
+    }
+
+    template <typename TAccountOperation>
+    void run_random_transfers(int no_of_threads, std::size_t no_of_accounts, int no_of_operations, TAccountOperation transfer)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(no_of_threads);
+
+        for (int i = 0; i < no_of_threads; ++i)
+        {
+            threads.emplace_back([=] {
+                std::minstd_rand rnd_gen(i + 1);
+                std::uniform_int_distribution<std::size_t> rnd_id(0, no_of_accounts - 1);
+
+                for (int op = 0; op < no_of_operations; ++op)
+                    transfer(rnd_id(rnd_gen), rnd_id(rnd_gen));
+            });
+        }
+
+        for (auto& thd : threads)
+            thd.join();
+    }
+
+    int max_no_of_threads()
+    {
+        return static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    }
+}
+
+TEMPLATE_TEST_CASE("bank account - withdraws & deposits from many threads", "[bank_account]", BankAccount, AtomicBankAccount, CombiningBankAccount)
+{
+    constexpr int NO_OF_ITERS = 100'000;
+
+    TestType ba(1, 10'000);
+
+    run_withdraws_and_deposits(ba, 4, NO_OF_ITERS);
+
+    CHECK(ba.balance() == Catch::Approx(10'000));
+}
+
+TEMPLATE_TEST_CASE("bank account - transfers in opposite directions", "[bank_account]", BankAccount, AtomicBankAccount, CombiningBankAccount)
+{
+    constexpr int NO_OF_ITERS = 100'000;
+
+    TestType ba1(1, 10'000);
+    TestType ba2(2, 10'000);
+
+    std::thread thd1(&make_transfers<TestType>, std::ref(ba1), std::ref(ba2), NO_OF_ITERS, 1);
+    std::thread thd2(&make_transfers<TestType>, std::ref(ba2), std::ref(ba1), NO_OF_ITERS, 2);
+
+    thd1.join();
+    thd2.join();
+
+    CHECK(ba1.balance() == Catch::Approx(10'000));
+    CHECK(ba2.balance() == Catch::Approx(10'000));
+}
+
+TEMPLATE_TEST_CASE("bank account - bounds-checked withdraw", "[bank_account]", BankAccount, AtomicBankAccount, CombiningBankAccount)
+{
+    TestType ba(1, 100.0);
+
+    SECTION("enough money")
+    {
+        CHECK(ba.try_withdraw(99.99));
+        CHECK(ba.balance() == Catch::Approx(0.01));
+    }
+
+    SECTION("not enough money")
+    {
+        CHECK_FALSE(ba.try_withdraw(100.01));
+        CHECK(ba.balance() == Catch::Approx(100.0));
+    }
+
+    SECTION("never goes below zero under contention")
+    {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.emplace_back([&ba] {
+                for (int i = 0; i < 1'000; ++i)
+                    (void)ba.try_withdraw(1.0);
+            });
+
+        for (auto& thd : threads)
+            thd.join();
+
+        CHECK(ba.balance() == Catch::Approx(0.0));
+    }
+}
+
+TEST_CASE("bank account - ordered transfers in opposite directions", "[bank_account]")
+{
+    constexpr int NO_OF_ITERS = 100'000;
+
+    BankAccount ba1(1, 10'000);
+    BankAccount ba2(2, 10'000);
+
+    std::thread thd1(&make_ordered_transfers<BankAccount>, std::ref(ba1), std::ref(ba2), NO_OF_ITERS, 1);
+    std::thread thd2(&make_ordered_transfers<BankAccount>, std::ref(ba2), std::ref(ba1), NO_OF_ITERS, 2);
+
+    thd1.join();
+    thd2.join();
+
+    CHECK(ba1.balance() == Catch::Approx(10'000));
+    CHECK(ba2.balance() == Catch::Approx(10'000));
+
+    const auto stats = ba1.lock_stats();
+    CHECK(stats.retries == 0); // ordered locking never calls try_lock
+
+    ba1.reset_lock_stats();
+    CHECK(ba1.lock_stats().waits == 0);
+}
+
+TEST_CASE("combining bank account - own deposits are visible when deposit returns", "[bank_account]")
+{
+    constexpr int NO_OF_ITERS = 10'000;
+
+    CombiningBankAccount ba(1, 0.0);
+    bool deposits_are_visible = true;
+
+    auto make_checked_deposits = [&ba](bool& deposits_are_visible) {
+        for (int i = 1; i <= NO_OF_ITERS; ++i)
+        {
+            ba.deposit(1.0);
+            if (ba.balance() < i) // other threads only deposit
+                deposits_are_visible = false;
+        }
+    };
+
+    bool other_deposits_are_visible = true;
+    std::thread thd1{make_checked_deposits, std::ref(deposits_are_visible)};
+    std::thread thd2{make_checked_deposits, std::ref(other_deposits_are_visible)};
+    thd1.join();
+    thd2.join();
+
+    CHECK(deposits_are_visible);
+    CHECK(other_deposits_are_visible);
+    CHECK(ba.balance() == 2 * NO_OF_ITERS);
+}
+
+TEST_CASE("bank account - lock-free balance reads during writes", "[bank_account]")
+{
+    constexpr int NO_OF_ITERS = 100'000;
+
+    BankAccount ba(1, 0.0);
+    std::atomic<bool> done{false};
+    bool reads_are_consistent = true;
+
+    std::thread reader{[&] {
+        double prev_balance = 0.0;
+        while (!done)
+        {
+            const double balance = ba.balance();
+            if (balance < prev_balance || balance != static_cast<int>(balance))
+                reads_are_consistent = false;
+            prev_balance = balance;
+        }
+    }};
+
+    make_deposits(ba, NO_OF_ITERS);
+    done = true;
+    reader.join();
+
+    CHECK(reads_are_consistent);
+    CHECK(ba.balance() == ba.balance_locked());
+    CHECK(ba.balance() == Catch::Approx(NO_OF_ITERS));
+}
+
+TEST_CASE("instrumented mutex - contention counters", "[bank_account]")
+{
+    using namespace std::chrono_literals;
+
+    InstrumentedMutex mtx;
+
+    std::unique_lock lk{mtx};
+
+    bool locked_by_other_thread = true;
+    std::thread{[&mtx, &locked_by_other_thread] { locked_by_other_thread = mtx.try_lock(); }}.join();
+    CHECK_FALSE(locked_by_other_thread);
+    CHECK(mtx.stats().retries == 1);
+
+    std::thread waiter{[&mtx] { std::lock_guard lk{mtx}; }};
+    std::this_thread::sleep_for(20ms);
+    lk.unlock();
+    waiter.join();
+
+    const auto stats = mtx.stats();
+    CHECK(stats.waits == 1);
+    CHECK(stats.wait_time > 0ns);
+}
+
+TEST_CASE("atomic bank account - balance is exact in cents", "[bank_account]")
+{
+    AtomicBankAccount ba(1, 0.0);
+
+    for (int i = 0; i < 1'000'000; ++i)
+        ba.deposit(0.1);
+
+    CHECK(ba.balance() == 100'000.0);
+}
+
+TEST_CASE("bank account - mutex vs atomic", "[.][benchmark]")
+{
+    constexpr int NO_OF_ITERS = 100'000;
+
+    for (int no_of_threads = 1; no_of_threads <= max_no_of_threads(); no_of_threads *= 2)
+    {
+        BENCHMARK("BankAccount - " + std::to_string(no_of_threads) + " threads")
+        {
+            BankAccount ba(1, 10'000);
+            run_withdraws_and_deposits(ba, no_of_threads, NO_OF_ITERS);
+            return ba.balance();
+        };
+
+        BENCHMARK("AtomicBankAccount - " + std::to_string(no_of_threads) + " threads")
+        {
+            AtomicBankAccount ba(1, 10'000);
+            run_withdraws_and_deposits(ba, no_of_threads, NO_OF_ITERS);
+            return ba.balance();
+        };
+    }
+}
+
+TEST_CASE("account ledger", "[account_ledger]")
+{
+    AccountLedger ledger(100, 1'000.0, 4);
+
+    REQUIRE(ledger.size() == 100);
+    REQUIRE(ledger.no_of_stripes() == 4);
+    CHECK(ledger.total() == Catch::Approx(100'000.0));
+
+    SECTION("deposit & withdraw")
+    {
+        ledger.deposit(7, 100.0);
+        ledger.withdraw(8, 50.0);
+
+        CHECK(ledger.balance(7) == Catch::Approx(1'100.0));
+        CHECK(ledger.balance(8) == Catch::Approx(950.0));
+        CHECK(ledger.total() == Catch::Approx(100'050.0));
+    }
+
+    SECTION("transfer within a stripe & across stripes")
+    {
+        ledger.transfer(0, 1, 10.0);
+        ledger.transfer(0, 99, 20.0);
+
+        CHECK(ledger.balance(0) == Catch::Approx(970.0));
+        CHECK(ledger.balance(1) == Catch::Approx(1'010.0));
+        CHECK(ledger.balance(99) == Catch::Approx(1'020.0));
+    }
+
+    SECTION("concurrent random transfers preserve total")
+    {
+        run_random_transfers(4, ledger.size(), 50'000, [&ledger](auto from, auto to) { ledger.transfer(from, to, 1.0); });
+
+        CHECK(ledger.total() == Catch::Approx(100'000.0));
+    }
+}
+
+TEST_CASE("account ledger vs vector of bank accounts", "[.][benchmark]")
+{
+    constexpr std::size_t NO_OF_ACCOUNTS = 10'000;
+    constexpr int NO_OF_ITERS = 100'000;
+
+    // BankAccount is neither copyable nor movable - std::deque keeps it in contiguous chunks like a vector
+    std::deque<BankAccount> accounts;
+    for (std::size_t id = 0; id < NO_OF_ACCOUNTS; ++id)
+        accounts.emplace_back(static_cast<int>(id), 1'000.0);
+
+    AccountLedger ledger(NO_OF_ACCOUNTS, 1'000.0);
+
+    for (int no_of_threads = 1; no_of_threads <= max_no_of_threads(); no_of_threads *= 2)
+    {
+        BENCHMARK("BankAccounts - " + std::to_string(no_of_threads) + " threads")
+        {
+            run_random_transfers(no_of_threads, NO_OF_ACCOUNTS, NO_OF_ITERS, [&accounts](auto from, auto to) {
+                if (from != to)
+                    accounts[from].transfer(accounts[to], 1.0);
+            });
+        };
+
+        BENCHMARK("AccountLedger - " + std::to_string(no_of_threads) + " threads")
+        {
+            run_random_transfers(no_of_threads, NO_OF_ACCOUNTS, NO_OF_ITERS, [&ledger](auto from, auto to) { ledger.transfer(from, to, 1.0); });
+        };
+    }
+}
+
+TEST_CASE("transfer batch", "[transfer_batch]")
+{
+    constexpr int NO_OF_ACCOUNTS = 8;
+    constexpr int NO_OF_TRANSFERS = 10'000;
+
+    std::deque<BankAccount> accounts_one_by_one;
+    std::deque<BankAccount> accounts_batched;
+    for (int id = 0; id < NO_OF_ACCOUNTS; ++id)
+    {
+        accounts_one_by_one.emplace_back(id, 1'000.0);
+        accounts_batched.emplace_back(id, 1'000.0);
+    }
+
+    std::minstd_rand rnd_gen(42);
+    std::uniform_int_distribution<int> rnd_id(0, NO_OF_ACCOUNTS - 1);
+    std::uniform_int_distribution<int> rnd_amount(1, 100);
+
+    std::vector<TransferBatch<BankAccount>::Record> records;
+    for (int i = 0; i < NO_OF_TRANSFERS; ++i)
+    {
+        const int from = rnd_id(rnd_gen);
+        const int to = rnd_id(rnd_gen);
+        if (from == to)
+            continue;
+
+        const double amount = rnd_amount(rnd_gen) / 4.0; // exactly representable - summation order does not matter
+
+        accounts_one_by_one[from].transfer(accounts_one_by_one[to], amount);
+        records.push_back({&accounts_batched[from], &accounts_batched[to], amount});
+    }
+
+    TransferBatch<BankAccount> batch;
+    batch.apply(records);
+
+    for (int id = 0; id < NO_OF_ACCOUNTS; ++id)
+        CHECK(accounts_batched[id].balance() == accounts_one_by_one[id].balance());
+}
+
+TEST_CASE("transfer batch - decimal amounts give the same balances as one by one", "[transfer_batch]")
+{
+    BankAccount ba1(1, 0.0);
+    BankAccount ba2(2, 0.0);
+    BankAccount ba3(2, 0.0); // same id as ba2 - grouped by address
+    BankAccount ref1(1, 0.0);
+    BankAccount ref2(2, 0.0);
+    BankAccount ref3(2, 0.0);
+
+    std::vector<TransferBatch<BankAccount>::Record> records(10, {&ba1, &ba2, 0.1}); // 10 x 0.1 != 1.0 in double
+    records.push_back({&ba2, &ba1, 1.0});
+    records.push_back({&ba1, &ba3, 0.005}); // sub-cent amounts are kept
+    records.push_back({&ba3, &ba2, 0.001});
+
+    for (const auto& rec : records)
+    {
+        BankAccount& from = rec.from == &ba1 ? ref1 : rec.from == &ba2 ? ref2 : ref3;
+        BankAccount& to = rec.to == &ba1 ? ref1 : rec.to == &ba2 ? ref2 : ref3;
+        from.transfer(to, rec.amount);
+    }
+
+    TransferBatch<BankAccount> batch;
+    batch.apply(records);
+
+    CHECK(ba1.balance() == ref1.balance());
+    CHECK(ba2.balance() == ref2.balance());
+    CHECK(ba3.balance() == ref3.balance());
+    CHECK(ba3.balance() == Catch::Approx(0.004));
+}
+
+TEST_CASE("transfer batch - opposite directions from many threads", "[transfer_batch]")
+{
+    constexpr int NO_OF_ITERS = 100'000;
+    constexpr int BATCH_SIZE = 1'000;
+
+    BankAccount ba1(1, 10'000);
+    BankAccount ba2(2, 10'000);
+
+    auto make_batched_transfers = [](BankAccount& from, BankAccount& to) {
+        std::vector<TransferBatch<BankAccount>::Record> records(BATCH_SIZE, {&from, &to, 1.0});
+        TransferBatch<BankAccount> batch;
+
+        for (int i = 0; i < NO_OF_ITERS; i += BATCH_SIZE)
+            batch.apply(records);
+    };
+
+    std::thread thd1(make_batched_transfers, std::ref(ba1), std::ref(ba2));
+    std::thread thd2(make_batched_transfers, std::ref(ba2), std::ref(ba1));
+
+    thd1.join();
+    thd2.join();
+
+    CHECK(ba1.balance() == Catch::Approx(10'000));
+    CHECK(ba2.balance() == Catch::Approx(10'000));
+}
+
+TEST_CASE("transfer batch vs make_transfers", "[.][benchmark]")
+{
+    constexpr int NO_OF_ITERS = 100'000;
+    constexpr int BATCH_SIZE = 1'000;
+
+    BankAccount ba1(1, 10'000);
+    BankAccount ba2(2, 10'000);
+
+    BENCHMARK("make_transfers")
+    {
+        std::thread thd1(&make_transfers<BankAccount>, std::ref(ba1), std::ref(ba2), NO_OF_ITERS, 1);
+        std::thread thd2(&make_transfers<BankAccount>, std::ref(ba2), std::ref(ba1), NO_OF_ITERS, 2);
+        thd1.join();
+        thd2.join();
+    };
+
+    auto make_batched_transfers = [](BankAccount& from, BankAccount& to) {
+        std::vector<TransferBatch<BankAccount>::Record> records(BATCH_SIZE, {&from, &to, 1.0});
+        TransferBatch<BankAccount> batch;
+
+        for (int i = 0; i < NO_OF_ITERS; i += BATCH_SIZE)
+            batch.apply(records);
+    };
+
+    BENCHMARK("TransferBatch - " + std::to_string(BATCH_SIZE) + " transfers per batch")
+    {
+        std::thread thd1(make_batched_transfers, std::ref(ba1), std::ref(ba2));
+        std::thread thd2(make_batched_transfers, std::ref(ba2), std::ref(ba1));
+        thd1.join();
+        thd2.join();
+    };
+}
+
+TEST_CASE("transfers - try & back-off vs ordered locking", "[.][benchmark]")
+{
+    constexpr int NO_OF_ITERS = 100'000;
+
+    BankAccount ba1(1, 10'000);
+    BankAccount ba2(2, 10'000);
+
+    auto print_lock_stats = [](const BankAccount& ba) {
+        const auto stats = ba.lock_stats();
+        std::cout << "Bank Account #" << ba.id() << " - waits: " << stats.waits << "; retries: " << stats.retries
+                  << "; wait time: " << std::chrono::duration_cast<std::chrono::microseconds>(stats.wait_time).count() << "us\n";
+    };
+
+    BENCHMARK("std::scoped_lock")
+    {
+        std::thread thd1(&make_transfers<BankAccount>, std::ref(ba1), std::ref(ba2), NO_OF_ITERS, 1);
+        std::thread thd2(&make_transfers<BankAccount>, std::ref(ba2), std::ref(ba1), NO_OF_ITERS, 2);
+        thd1.join();
+        thd2.join();
+    };
+
+    print_lock_stats(ba1);
+    print_lock_stats(ba2);
+    ba1.reset_lock_stats();
+    ba2.reset_lock_stats();
+
+    BENCHMARK("ordered locking")
+    {
+        std::thread thd1(&make_ordered_transfers<BankAccount>, std::ref(ba1), std::ref(ba2), NO_OF_ITERS, 1);
+        std::thread thd2(&make_ordered_transfers<BankAccount>, std::ref(ba2), std::ref(ba1), NO_OF_ITERS, 2);
+        thd1.join();
+        thd2.join();
+    };
+
+    print_lock_stats(ba1);
+    print_lock_stats(ba2);
+}
+
+TEST_CASE("balance polling - atomic load vs mutex", "[.][benchmark]")
+{
+    constexpr int NO_OF_ITERS = 100'000;
+
+    auto run_writers_with_readers = [](int no_of_readers, auto read_balance) {
+        BankAccount ba(1, 10'000);
+        std::atomic<bool> done{false};
+
+        std::vector<std::thread> readers;
+        for (int i = 0; i < no_of_readers; ++i)
+            readers.emplace_back([&] {
+                while (!done)
+                    read_balance(ba);
+            });
+
+        run_withdraws_and_deposits(ba, 2, NO_OF_ITERS);
+
+        done = true;
+        for (auto& thd : readers)
+            thd.join();
+
+        return ba.balance();
+    };
+
+    for (int no_of_readers = 1; no_of_readers <= max_no_of_threads(); no_of_readers *= 2)
+    {
+        BENCHMARK("writers + " + std::to_string(no_of_readers) + " readers - mutex")
+        {
+            return run_writers_with_readers(no_of_readers, [](const BankAccount& ba) { return ba.balance_locked(); });
+        };
+
+        BENCHMARK("writers + " + std::to_string(no_of_readers) + " readers - atomic load")
+        {
+            return run_writers_with_readers(no_of_readers, [](const BankAccount& ba) { return ba.balance(); });
+        };
+    }
+}
+
+TEST_CASE("bank - consistent snapshots during transfers", "[bank]")
+{
+    constexpr int NO_OF_ACCOUNTS = 16;
+    constexpr int NO_OF_ITERS = 50'000;
+
+    std::deque<BankAccount> accounts;
+    Bank bank;
+    for (int id = 0; id < NO_OF_ACCOUNTS; ++id)
+        bank.add(accounts.emplace_back(id, 1'000.0));
+
+    REQUIRE(bank.size() == NO_OF_ACCOUNTS);
+    CHECK(bank.total() == Catch::Approx(NO_OF_ACCOUNTS * 1'000.0));
+
+    std::atomic<bool> done{false};
+    int no_of_snapshots = 0;
+    int no_of_inconsistent_snapshots = 0;
+
+    std::thread auditor{[&] {
+        while (!done)
+        {
+            const auto snapshot = bank.snapshot();
+            ++no_of_snapshots;
+            if (snapshot.total != NO_OF_ACCOUNTS * 1'000.0)
+                ++no_of_inconsistent_snapshots;
+        }
+    }};
+
+    run_random_transfers(4, NO_OF_ACCOUNTS, NO_OF_ITERS, [&accounts](auto from, auto to) {
+        if (from != to)
+            accounts[from].transfer(accounts[to], 1.0);
+    });
+
+    done = true;
+    auditor.join();
+
+    INFO("snapshots taken: " << no_of_snapshots);
+    CHECK(no_of_inconsistent_snapshots == 0);
+
+    const auto final_snapshot = bank.snapshot();
+    for (const auto& [id, balance] : final_snapshot.balances)
+        CHECK(balance == accounts[id].balance());
+}
+
+TEST_CASE("bank - snapshot latency & writer slowdown", "[.][benchmark]")
+{
+    constexpr int NO_OF_ACCOUNTS = 1'000;
+    constexpr int NO_OF_ITERS = 100'000;
+
+    std::deque<BankAccount> plain_accounts;
+    std::deque<BankAccount> bank_accounts;
+    Bank bank;
+    for (int id = 0; id < NO_OF_ACCOUNTS; ++id)
+    {
+        plain_accounts.emplace_back(id, 1'000.0);
+        bank.add(bank_accounts.emplace_back(id, 1'000.0));
+    }
+
+    auto make_random_transfers = [](std::deque<BankAccount>& accounts) {
+        run_random_transfers(2, accounts.size(), NO_OF_ITERS, [&accounts](auto from, auto to) {
+            if (from != to)
+                accounts[from].transfer(accounts[to], 1.0);
+        });
+    };
+
+    BENCHMARK("transfers - accounts without snapshots")
+    {
+        make_random_transfers(plain_accounts);
+    };
+
+    BENCHMARK("transfers - accounts in a bank (no snapshots taken)")
+    {
+        make_random_transfers(bank_accounts);
+    };
+
+    std::atomic<bool> done{false};
+    std::thread auditor{[&] {
+        while (!done)
+            bank.snapshot();
+    }};
+
+    BENCHMARK("transfers - accounts in a bank (snapshots taken continuously)")
+    {
+        make_random_transfers(bank_accounts);
+    };
+
+    done = true;
+    auditor.join();
+
+    BENCHMARK("snapshot - idle writers")
+    {
+        return bank.snapshot().total;
+    };
+
+    std::thread writers{[&] { make_random_transfers(bank_accounts); }};
+
+    BENCHMARK("snapshot - busy writers")
+    {
+        return bank.snapshot().total;
+    };
+
+    writers.join();
+}
+
+TEST_CASE("money", "[money]")
+{
+    using namespace MoneyLiterals;
+
+    static_assert(150_cents + 250_cents == 400_cents);
+    static_assert(-150_cents < 0_cents);
+
+    SECTION("no drift under many operations")
+    {
+        Money balance;
+        for (int i = 0; i < 1'000'000; ++i)
+            balance += Money::from_double(0.1);
+
+        CHECK(balance == Money::from_cents(10'000'000));
+        CHECK(balance.to_double() == 100'000.0);
+    }
+
+    SECTION("rate is rounded half away from zero")
+    {
+        constexpr auto half = Rate::from_nanos(Rate::scale / 2);
+
+        static_assert((1_cents * half).cents() == 1);   // 0.5 -> 1
+        static_assert((-1_cents * half).cents() == -1); // -0.5 -> -1
+        static_assert((3_cents * half).cents() == 2);   // 1.5 -> 2
+        static_assert((2_cents * half).cents() == 1);
+
+        CHECK((10'000_cents * Rate::from_double(0.05)).cents() == 500);
+    }
+
+    SECTION("decimal rates are exact")
+    {
+        CHECK((Money::from_cents(100'000'000'000) * Rate::from_double(0.0001)).cents() == 10'000'000);
+        CHECK((Money::from_cents(36'500'000'000) * Rate::from_nanos(136'986)).cents() == 4'999'989);
+    }
+
+    SECTION("large balances do not overflow")
+    {
+        constexpr auto balance = Money::from_cents(4'000'000'000'000'000'000);
+
+        static_assert((balance * Rate::from_nanos(Rate::scale)).cents() == balance.cents());
+        static_assert((balance * Rate::from_nanos(-Rate::scale / 4)).cents() == -balance.cents() / 4);
+    }
+
+    SECTION("division by the scale is exact")
+    {
+        auto reference = [](std::int64_t cents, std::int64_t nanos) { // with divide instructions
+            const auto abs_cents = cents < 0 ? -cents : cents;
+            const auto abs_nanos = nanos < 0 ? -nanos : nanos;
+            const auto rounded = abs_cents / Rate::scale * abs_nanos + (abs_cents % Rate::scale * abs_nanos + Rate::scale / 2) / Rate::scale;
+            return (cents < 0) != (nanos < 0) ? -rounded : rounded;
+        };
+
+        std::mt19937_64 rnd_gen{665};
+        std::uniform_int_distribution<std::int64_t> rnd_cents(-(std::int64_t{1} << 53), std::int64_t{1} << 53);
+        std::uniform_int_distribution<std::int64_t> rnd_nanos(-Rate::scale, Rate::scale);
+
+        bool all_exact = true;
+        for (int i = 0; i < 1'000'000; ++i)
+        {
+            const auto cents = i % 4 == 0 ? i * Rate::scale / 2 + i % 3 - 1 : rnd_cents(rnd_gen); // ties & values near multiples of the scale
+            const auto nanos = i % 2 == 0 ? Rate::scale / 2 : rnd_nanos(rnd_gen);
+            all_exact = all_exact && apply_rate(cents, Rate::from_nanos(nanos)) == reference(cents, nanos);
+        }
+
+        CHECK(all_exact);
+    }
+
+    SECTION("printing")
+    {
+        std::ostringstream out;
+        out << Money::from_cents(123'405) << " " << -5_cents;
+        CHECK(out.str() == "1234.05 -0.05");
+    }
+}
+
+TEST_CASE("balance column - end of day", "[money]")
+{
+    const EndOfDayPolicy policy{Rate::from_double(0.05 / 365), Money::from_cents(250), Money::from_cents(100'000)};
+
+    std::minstd_rand rnd_gen(665);
+    std::uniform_int_distribution<std::int64_t> rnd_cents(-1'000'000, 100'000'000);
+
+    BalanceColumn column;
+    std::vector<Money> balances;
+    for (int i = 0; i < 100'000; ++i)
+    {
+        const auto balance = Money::from_cents(rnd_cents(rnd_gen));
+        column.push_back(balance);
+        balances.push_back(balance);
+    }
+
+    column.apply_end_of_day(policy);
+
+    bool same_as_scalar_path = true;
+    for (std::size_t i = 0; i < balances.size(); ++i)
+        same_as_scalar_path = same_as_scalar_path && column[i] == end_of_day(balances[i], policy);
+
+    CHECK(same_as_scalar_path);
+
+    SECTION("fee is waived above threshold")
+    {
+        BalanceColumn small_column(2, Money::from_cents(50'000));
+        small_column.set(1, Money::from_cents(200'000));
+
+        small_column.apply_end_of_day({Rate{}, Money::from_cents(250), Money::from_cents(100'000)});
+
+        CHECK(small_column[0] == Money::from_cents(49'750));
+        CHECK(small_column[1] == Money::from_cents(200'000));
+    }
+}
+
+TEST_CASE("end of day - columnar pass vs per-account loop", "[.][benchmark]")
+{
+    constexpr std::size_t NO_OF_ACCOUNTS = 1'000'000;
+
+    struct AccountRecord
+    {
+        int id;
+        Money balance;
+        std::int64_t last_operation_timestamp;
+    };
+
+    const EndOfDayPolicy policy{Rate::from_double(0.05 / 365), Money::from_cents(250), Money::from_cents(100'000)};
+
+    std::vector<AccountRecord> records;
+    BalanceColumn column;
+    for (std::size_t i = 0; i < NO_OF_ACCOUNTS; ++i)
+    {
+        const auto balance = Money::from_cents(static_cast<std::int64_t>(i * 7919 % 10'000'000));
+        records.push_back({static_cast<int>(i), balance, 0});
+        column.push_back(balance);
+    }
+
+    BENCHMARK("per-account loop")
+    {
+        for (auto& record : records)
+            record.balance = end_of_day(record.balance, policy);
+        return records.back().balance;
+    };
+
+    BENCHMARK("columnar pass")
+    {
+        column.apply_end_of_day(policy);
+        return column[NO_OF_ACCOUNTS - 1];
+    };
+}
+
+#if __has_include(<sys/mman.h>)
+
+TEST_CASE("transaction journal", "[journal]")
+{
+    const auto journal_path = (std::filesystem::temp_directory_path() / "tests_bank_account_journal.bin").string();
+    std::filesystem::remove(journal_path);
+
+    constexpr int NO_OF_ITERS = 10'000;
+
+    {
+        TransactionJournal journal{journal_path, 1'000'000, {512, std::chrono::milliseconds{5}}};
+
+        BankAccount ba1(1, 10'000);
+        BankAccount ba2(2, 5'000);
+        ba1.attach_log(journal);
+        ba2.attach_log(journal);
+
+        std::thread thd1(&make_transfers<BankAccount>, std::ref(ba1), std::ref(ba2), NO_OF_ITERS, 1);
+        std::thread thd2(&make_withdraws<BankAccount>, std::ref(ba2), NO_OF_ITERS);
+        std::thread thd3(&make_deposits<BankAccount>, std::ref(ba1), NO_OF_ITERS / 2);
+        thd1.join();
+        thd2.join();
+        thd3.join();
+
+        CHECK(journal.size() == 2 + 2 * NO_OF_ITERS + NO_OF_ITERS / 2);
+    }
+
+    SECTION("replay rebuilds balances")
+    {
+        const auto balances = TransactionJournal::replay(journal_path);
+
+        REQUIRE(balances.size() == 2);
+        CHECK(balances.at(1) == Catch::Approx(10'000 - NO_OF_ITERS + NO_OF_ITERS / 2));
+        CHECK(balances.at(2) == Catch::Approx(5'000));
+    }
+
+    SECTION("reopened journal appends after last record")
+    {
+        TransactionJournal journal{journal_path, 0};
+        CHECK(journal.size() == 2 + 2 * NO_OF_ITERS + NO_OF_ITERS / 2);
+
+        journal.append(Operation::deposit, 2, 100.0);
+        journal.sync();
+
+        CHECK(TransactionJournal::replay(journal_path).at(2) == Catch::Approx(5'100));
+    }
+
+    SECTION("full batch is flushed in the background before the window ends")
+    {
+        constexpr std::uint64_t BATCH_SIZE = 64;
+
+        TransactionJournal journal{journal_path, 0, {BATCH_SIZE, std::chrono::hours{1}}};
+        const auto size_before = journal.size();
+        journal.sync();
+
+        for (std::uint64_t i = 0; i < BATCH_SIZE; ++i)
+            journal.append(Operation::deposit, 2, 1.0);
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        while (journal.flushed() < size_before + BATCH_SIZE && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+
+        CHECK(journal.flushed() == size_before + BATCH_SIZE);
+    }
+
+    SECTION("full journal rejects the operation")
+    {
+        const auto small_journal_path = journal_path + ".small";
+        std::filesystem::remove(small_journal_path);
+
+        {
+            TransactionJournal journal{small_journal_path, 2};
+            BankAccount ba(1, 100);
+            ba.attach_log(journal);
+
+            ba.deposit(1.0);
+            CHECK_THROWS_AS(ba.deposit(1.0), std::length_error);
+            CHECK(ba.balance() == Catch::Approx(101.0));
+        }
+
+        std::filesystem::remove(small_journal_path);
+    }
+
+    SECTION("truncated journal is rejected")
+    {
+        std::filesystem::resize_file(journal_path, std::filesystem::file_size(journal_path) / 2);
+
+        CHECK_THROWS_AS(TransactionJournal(journal_path, 0), std::runtime_error);
+    }
+
+    std::filesystem::remove(journal_path);
+}
+
+TEST_CASE("bank account - with and without journal", "[.][benchmark]")
+{
+    constexpr int NO_OF_ITERS = 100'000;
+
+    const auto journal_path = (std::filesystem::temp_directory_path() / "bench_bank_account_journal.bin").string();
+
+    BENCHMARK("without journal")
+    {
+        BankAccount ba(1, 10'000);
+        run_withdraws_and_deposits(ba, 2, NO_OF_ITERS);
+        return ba.balance();
+    };
+
+    BENCHMARK_ADVANCED("with journal")(Catch::Benchmark::Chronometer meter)
+    {
+        std::filesystem::remove(journal_path);
+        TransactionJournal journal{journal_path, static_cast<std::uint64_t>(meter.runs()) * 2 * NO_OF_ITERS + 1};
+
+        BankAccount ba(1, 10'000);
+        ba.attach_log(journal);
+
+        meter.measure([&] {
+            run_withdraws_and_deposits(ba, 2, NO_OF_ITERS);
+            journal.sync();
+        });
+    };
+
+    std::filesystem::remove(journal_path);
+}
+
+#endif
+
+TEST_CASE("hot account - mutex vs atomic vs flat combining", "[.][benchmark]")
+{
+    constexpr int NO_OF_ITERS = 10'000;
+
+    for (int no_of_threads : {2, 8, 32})
+    {
+        BENCHMARK("BankAccount - " + std::to_string(no_of_threads) + " threads")
+        {
+            BankAccount ba(1, 10'000);
+            run_withdraws_and_deposits(ba, no_of_threads, NO_OF_ITERS);
+            return ba.balance();
+        };
+
+        BENCHMARK("AtomicBankAccount - " + std::to_string(no_of_threads) + " threads")
+        {
+            AtomicBankAccount ba(1, 10'000);
+            run_withdraws_and_deposits(ba, no_of_threads, NO_OF_ITERS);
+            return ba.balance();
+        };
+
+        BENCHMARK("CombiningBankAccount - " + std::to_string(no_of_threads) + " threads")
+        {
+            CombiningBankAccount ba(1, 10'000);
+            run_withdraws_and_deposits(ba, no_of_threads, NO_OF_ITERS);
+            return ba.balance();
+        };
+    }
+}
@@ -12,6 +12,8 @@
 #include <vector>
 #include <array>
 
+#include "bank_account.hpp"
+
 using namespace std;
 
 TEST_CASE("if with initializer")
@@ -58,83 +60,7 @@ TEST_CASE("if with mutex")
 }
 
 ///////////////////////////////////////
-// scoped locks
-
-class BankAccount
-{
-    const int id_;
-    double balance_;
-    mutable std::mutex mtx_balance_;
-
-public:
-    BankAccount(int id, double balance)
-        : id_(id)
-        , balance_(balance)
-    {
-    }
-
-    void print() const
-    {
-        std::cout << "Bank Account #" << id_ << "; Balance = " << balance() << std::endl;
-    }
-
-    void transfer(BankAccount& to, double amount)
-    {
-        // std::unique_lock lk_from{mtx_balance_, std::defer_lock};
-        // std::unique_lock lk_to{to.mtx_balance_, std::defer_lock};
-
-        // std::lock(lk_from, lk_to); // deadlock-free lock
-
-        // since C++17
-        std::scoped_lock lks{mtx_balance_, to.mtx_balance_};
-
-        balance_ -= amount;
-        to.balance_ += amount;
-    }
-
-    void withdraw(double amount)
-    {
-        std::lock_guard lk{mtx_balance_};
-        balance_ -= amount;
-    }
-
-    void deposit(double amount)
-    {
-        std::scoped_lock lk{mtx_balance_};
-        balance_ += amount;
-    }
-
-    int id() const
-    {
-        return id_;
-    }
-
-    double balance() const
-    {
-        std::lock_guard lk{mtx_balance_};
-        return balance_;
-    }
-};
-
-void make_withdraws(BankAccount& ba, int no_of_operations)
-{
-    for (int i = 0; i < no_of_operations; ++i)
-        ba.withdraw(1.0);
-}
-
-void make_deposits(BankAccount& ba, int no_of_operations)
-{
-    for (int i = 0; i < no_of_operations; ++i)
-        ba.deposit(1.0);
-}
-
-void make_transfers(BankAccount& from, BankAccount& to, int no_of_operations, int thd_id)
-{
-    for (int i = 0; i < no_of_operations; ++i)
-    {
-        from.transfer(to, 1.0);
-    }
-}
+// scoped locks - see bank_account.hpp
 
 // TEST_CASE("locks")
 // {
@@ -143,8 +69,8 @@ void make_transfers(BankAccount& from, BankAccount& to, int no_of_operations, in
 //     BankAccount ba1(1, 10'000);
 //     BankAccount ba2(2, 10'000);
 
-//     std::thread thd1(&make_withdraws, std::ref(ba1), NO_OF_ITERS);
-//     std::thread thd2(&make_deposits, std::ref(ba1), NO_OF_ITERS);
+//     std::thread thd1(&make_withdraws<BankAccount>, std::ref(ba1), NO_OF_ITERS);
+//     std::thread thd2(&make_deposits<BankAccount>, std::ref(ba1), NO_OF_ITERS);
 
 //     thd1.join();
 //     thd2.join();
@@ -154,8 +80,8 @@ void make_transfers(BankAccount& from, BankAccount& to, int no_of_operations, in
 
 //     std::cout << "\nTransfer:" << std::endl;
 
-//     std::thread thd3(&make_transfers, std::ref(ba1), std::ref(ba2), NO_OF_ITERS, 1);
-//     std::thread thd4(&make_transfers, std::ref(ba2), std::ref(ba1), NO_OF_ITERS, 2);
+//     std::thread thd3(&make_transfers<BankAccount>, std::ref(ba1), std::ref(ba2), NO_OF_ITERS, 1);
+//     std::thread thd4(&make_transfers<BankAccount>, std::ref(ba2), std::ref(ba1), NO_OF_ITERS, 2);
 
 //     thd3.join();
 //     thd4.join();
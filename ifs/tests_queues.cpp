@@ -0,0 +1,598 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "blocking_queue.hpp"
+#include "message_channel.hpp"
+#include "mpmc_queue.hpp"
+#include "spsc_queue.hpp"
+
+using namespace std;
+
+namespace
+{
+    // the "if with mutex" pattern wrapped in the same interface as the lock-free queues
+    template <typename T>
+    class MutexQueue
+    {
+        std::queue<T> q_;
+        std::mutex mtx_q_;
+
+    public:
+        template <typename TItem>
+        bool push(TItem&& item)
+        {
+            std::lock_guard lk{mtx_q_};
+            q_.push(std::forward<TItem>(item));
+            return true;
+        }
+
+        template <typename TItem>
+        bool try_push(TItem&& item)
+        {
+            return push(std::forward<TItem>(item));
+        }
+
+        std::optional<T> try_pop()
+        {
+            if (std::unique_lock lk{mtx_q_}; !std::empty(q_))
+            {
+                std::optional<T> msg{std::move(q_.front())};
+                q_.pop();
+                return msg;
+            }
+
+            return std::nullopt;
+        }
+    };
+
+    // every producer pushes no_of_items numbers; returns sum of all consumed items
+    template <typename TQueue>
+    long long run_producers_consumers(TQueue& q, int no_of_producers, int no_of_consumers, int no_of_items)
+    {
+        std::atomic<long long> sum{0};
+        std::atomic<int> no_of_consumed{0};
+        const int no_of_all_items = no_of_producers * no_of_items;
+
+        std::vector<std::thread> threads;
+
+        for (int p = 0; p < no_of_producers; ++p)
+            threads.emplace_back([&q, no_of_items] {
+                for (int i = 1; i <= no_of_items; ++i)
+                    while (!q.try_push(i))
+                        std::this_thread::yield();
+            });
+
+        for (int c = 0; c < no_of_consumers; ++c)
+            threads.emplace_back([&] {
+                while (no_of_consumed < no_of_all_items)
+                {
+                    if (auto item = q.try_pop(); item)
+                    {
+                        sum += *item;
+                        ++no_of_consumed;
+                    }
+                    else
+                        std::this_thread::yield();
+                }
+            });
+
+        for (auto& thd : threads)
+            thd.join();
+
+        return sum;
+    }
+}
+
+TEST_CASE("bounded mpmc queue", "[queues]")
+{
+    BoundedMpmcQueue<std::string> q_msg{3};
+
+    REQUIRE(q_msg.capacity() == 4);
+
+    SECTION("try_pop on empty queue")
+    {
+        CHECK_FALSE(q_msg.try_pop().has_value());
+    }
+
+    SECTION("fifo order")
+    {
+        CHECK(q_msg.try_push("START"));
+        CHECK(q_msg.try_push(std::string("NEXT")));
+
+        if (auto msg = q_msg.try_pop(); msg)
+            CHECK(*msg == "START");
+        else
+            FAIL("queue should not be empty");
+
+        CHECK(q_msg.try_pop() == "NEXT");
+    }
+
+    SECTION("try_push on full queue")
+    {
+        for (int i = 0; i < 4; ++i)
+            CHECK(q_msg.try_push(std::to_string(i)));
+
+        CHECK_FALSE(q_msg.try_push("overflow"));
+
+        CHECK(q_msg.try_pop() == "0");
+        CHECK(q_msg.try_push("4"));
+    }
+
+    SECTION("items left in queue are destroyed")
+    {
+        auto item = std::make_shared<int>(42);
+        {
+            BoundedMpmcQueue<std::shared_ptr<int>> q{4};
+            CHECK(q.try_push(item));
+            CHECK(item.use_count() == 2);
+        }
+        CHECK(item.use_count() == 1);
+    }
+
+    SECTION("throwing item construction does not claim a cell")
+    {
+        struct Item
+        {
+            int value;
+
+            explicit Item(int value)
+                : value{value}
+            {
+                if (value < 0)
+                    throw std::invalid_argument("negative item");
+            }
+        };
+
+        BoundedMpmcQueue<Item> q{2};
+
+        CHECK_THROWS_AS(q.try_push(-1), std::invalid_argument);
+        CHECK(q.try_push(1));
+        CHECK(q.try_pop()->value == 1);
+        CHECK_FALSE(q.try_pop().has_value());
+    }
+}
+
+TEST_CASE("bounded mpmc queue - many producers & consumers", "[queues]")
+{
+    constexpr int NO_OF_ITEMS = 50'000;
+    constexpr long long SUM_OF_ITEMS = NO_OF_ITEMS * (NO_OF_ITEMS + 1LL) / 2;
+
+    BoundedMpmcQueue<int> q{256};
+
+    CHECK(run_producers_consumers(q, 4, 4, NO_OF_ITEMS) == 4 * SUM_OF_ITEMS);
+}
+
+TEST_CASE("spsc queue", "[queues]")
+{
+    SpscQueue<std::string> q_msg{4};
+
+    REQUIRE(q_msg.capacity() == 4);
+
+    SECTION("fifo order & full queue")
+    {
+        for (int i = 0; i < 4; ++i)
+            CHECK(q_msg.try_push(std::to_string(i)));
+        CHECK_FALSE(q_msg.try_push("overflow"));
+
+        CHECK(q_msg.try_pop() == "0");
+        CHECK(q_msg.try_push("4"));
+    }
+
+    SECTION("drain in batches")
+    {
+        for (int i = 0; i < 3; ++i)
+            CHECK(q_msg.try_push(std::to_string(i)));
+
+        std::vector<std::string> msgs;
+        CHECK(q_msg.drain(2, [&msgs](std::string&& msg) { msgs.push_back(std::move(msg)); }) == 2);
+        CHECK(q_msg.drain(100, [&msgs](std::string&& msg) { msgs.push_back(std::move(msg)); }) == 1);
+        CHECK(q_msg.drain(100, [&msgs](std::string&& msg) { msgs.push_back(std::move(msg)); }) == 0);
+
+        CHECK(msgs == std::vector<std::string>{"0", "1", "2"});
+    }
+}
+
+TEST_CASE("spsc queue - producer & consumer threads", "[queues]")
+{
+    constexpr int NO_OF_ITEMS = 200'000;
+
+    SpscQueue<int> q{128};
+    std::vector<int> received;
+    received.reserve(NO_OF_ITEMS);
+
+    std::thread producer{[&q] {
+        for (int i = 0; i < NO_OF_ITEMS; ++i)
+            while (!q.try_push(i))
+                std::this_thread::yield();
+    }};
+
+    while (received.size() < NO_OF_ITEMS)
+    {
+        if (q.drain(64, [&received](int item) { received.push_back(item); }) == 0)
+            std::this_thread::yield();
+    }
+
+    producer.join();
+
+    std::vector<int> expected(NO_OF_ITEMS);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(received == expected);
+}
+
+TEST_CASE("blocking queue", "[queues]")
+{
+    using namespace std::chrono_literals;
+
+    BlockingQueue<std::string> q_msg;
+
+    SECTION("pop_for times out on empty queue")
+    {
+        const auto start = std::chrono::steady_clock::now();
+        CHECK_FALSE(q_msg.pop_for(20ms).has_value());
+        CHECK(std::chrono::steady_clock::now() - start >= 20ms);
+    }
+
+    SECTION("pop waits for producer")
+    {
+        std::thread producer{[&q_msg] {
+            std::this_thread::sleep_for(10ms);
+            q_msg.push("START");
+        }};
+
+        CHECK(q_msg.pop() == "START");
+        producer.join();
+    }
+
+    SECTION("close wakes up parked consumers")
+    {
+        std::vector<std::thread> consumers;
+        std::atomic<int> no_of_finished{0};
+        for (int i = 0; i < 3; ++i)
+            consumers.emplace_back([&] {
+                if (auto msg = q_msg.pop(); !msg)
+                    ++no_of_finished;
+            });
+
+        std::this_thread::sleep_for(10ms);
+        q_msg.close();
+
+        for (auto& thd : consumers)
+            thd.join();
+
+        CHECK(no_of_finished == 3);
+        CHECK(q_msg.is_closed());
+    }
+
+    SECTION("items pushed before close can be popped")
+    {
+        CHECK(q_msg.push("LAST"));
+        q_msg.close();
+
+        CHECK_FALSE(q_msg.push("TOO LATE"));
+        CHECK(q_msg.pop_for(1s) == "LAST");
+        CHECK_FALSE(q_msg.pop().has_value());
+    }
+}
+
+TEST_CASE("message channel", "[queues]")
+{
+    MessageChannel channel{64};
+
+    REQUIRE(channel.capacity() == 64);
+
+    SECTION("payload is received as a view into the channel")
+    {
+        CHECK(channel.try_send("START"));
+        CHECK(channel.try_send(""));
+
+        if (auto msg = channel.try_receive(); msg)
+        {
+            CHECK(msg->payload() == "START");
+            channel.acknowledge(*msg);
+        }
+        else
+            FAIL("channel should not be empty");
+
+        auto empty_msg = channel.try_receive();
+        REQUIRE(empty_msg.has_value());
+        CHECK(empty_msg->payload().empty());
+
+        CHECK_FALSE(channel.try_receive().has_value());
+    }
+
+    SECTION("storage is recycled only after acknowledge")
+    {
+        const std::string payload(20, 'x'); // 24 bytes with header
+
+        CHECK(channel.try_send(payload));
+        CHECK(channel.try_send(payload));
+        CHECK_FALSE(channel.try_send(payload));
+
+        auto msg = channel.try_receive();
+        REQUIRE(msg.has_value());
+        CHECK_FALSE(channel.try_send(payload)); // received but not acknowledged yet
+
+        channel.acknowledge(*msg);
+        CHECK(channel.try_send(payload)); // wraps around the end of the ring
+        CHECK(channel.try_receive()->payload() == payload);
+        CHECK(channel.try_receive()->payload() == payload);
+    }
+
+    SECTION("message larger than max payload size is rejected")
+    {
+        REQUIRE(channel.max_payload_size() == 28);
+
+        CHECK_FALSE(channel.try_send(std::string(100, 'x')));
+        CHECK_FALSE(channel.try_send(std::string(channel.max_payload_size() + 1, 'x')));
+    }
+
+    SECTION("message of max payload size fits into an empty channel at any offset")
+    {
+        const std::string payload(channel.max_payload_size(), 'b');
+
+        for (std::size_t prefix_size = 0; prefix_size <= channel.max_payload_size(); ++prefix_size)
+        {
+            CHECK(channel.try_send(std::string(prefix_size, 'a')));
+            channel.acknowledge(*channel.try_receive());
+
+            CHECK(channel.try_send(payload));
+            auto msg = channel.try_receive();
+            REQUIRE(msg.has_value());
+            CHECK(msg->payload() == payload);
+            channel.acknowledge(*msg);
+        }
+    }
+}
+
+TEST_CASE("message channel - zero allocations per message in steady state", "[queues]")
+{
+    constexpr int NO_OF_MSGS = 10'000;
+
+    MessageChannel channel{4096};
+    const std::string payload = "a message that does not fit in the small string buffer";
+    std::size_t sent_size = 0;
+    std::size_t received_size = 0;
+
+    const auto allocations_before = no_of_allocations_in_thread;
+
+    for (int i = 0; i < NO_OF_MSGS; ++i)
+    {
+        const auto msg_payload = std::string_view{payload}.substr(i % payload.size());
+        if (channel.try_send(msg_payload))
+            sent_size += msg_payload.size();
+
+        if (auto msg = channel.try_receive(); msg)
+        {
+            received_size += msg->payload().size();
+            channel.acknowledge(*msg);
+        }
+    }
+
+    CHECK(no_of_allocations_in_thread - allocations_before == 0);
+    CHECK(received_size == sent_size);
+    CHECK(sent_size > NO_OF_MSGS);
+
+    SECTION("std::queue<std::string> allocates per message")
+    {
+        std::queue<std::string> q_msg;
+        const auto allocations_before = no_of_allocations_in_thread;
+
+        for (int i = 0; i < NO_OF_MSGS; ++i)
+        {
+            q_msg.push(payload);
+            std::string msg = q_msg.front();
+            q_msg.pop();
+        }
+
+        CHECK(no_of_allocations_in_thread - allocations_before >= NO_OF_MSGS);
+    }
+}
+
+TEST_CASE("message channel - producer & consumer threads", "[queues]")
+{
+    constexpr int NO_OF_MSGS = 100'000;
+
+    MessageChannel channel{1024};
+
+    std::thread producer{[&channel] {
+        for (int i = 0; i < NO_OF_MSGS; ++i)
+        {
+            const auto payload = std::to_string(i);
+            while (!channel.try_send(payload))
+                std::this_thread::yield();
+        }
+    }};
+
+    bool messages_in_order = true;
+    for (int i = 0; i < NO_OF_MSGS;)
+    {
+        if (auto msg = channel.try_receive(); msg)
+        {
+            messages_in_order = messages_in_order && msg->payload() == std::to_string(i);
+            channel.acknowledge(*msg);
+            ++i;
+        }
+        else
+            std::this_thread::yield();
+    }
+
+    producer.join();
+
+    CHECK(messages_in_order);
+}
+
+TEST_CASE("mutex queue vs bounded mpmc queue", "[.][benchmark]")
+{
+    constexpr int NO_OF_ITEMS = 100'000;
+
+    for (auto [no_of_producers, no_of_consumers] : {std::pair{1, 1}, std::pair{2, 2}, std::pair{4, 4}, std::pair{1, 4}, std::pair{4, 1}})
+    {
+        const auto config = std::to_string(no_of_producers) + " producers/" + std::to_string(no_of_consumers) + " consumers";
+
+        BENCHMARK("std::queue + std::mutex - " + config)
+        {
+            MutexQueue<int> q;
+            return run_producers_consumers(q, no_of_producers, no_of_consumers, NO_OF_ITEMS);
+        };
+
+        BENCHMARK("BoundedMpmcQueue - " + config)
+        {
+            BoundedMpmcQueue<int> q{1024};
+            return run_producers_consumers(q, no_of_producers, no_of_consumers, NO_OF_ITEMS);
+        };
+    }
+}
+
+namespace
+{
+    struct TimestampedMessage
+    {
+        std::chrono::steady_clock::time_point sent;
+        std::string payload;
+    };
+
+    void print_latency_report(const std::string& name, std::vector<std::chrono::nanoseconds>& latencies, std::chrono::nanoseconds elapsed)
+    {
+        std::sort(latencies.begin(), latencies.end());
+
+        auto percentile = [&latencies](double p) {
+            return latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))].count();
+        };
+
+        const auto msgs_per_sec = latencies.size() / std::chrono::duration<double>(elapsed).count();
+
+        std::cout << name << " - throughput: " << static_cast<long long>(msgs_per_sec) << " msg/s"
+                  << "; latency p50: " << percentile(0.5) << "ns; p99: " << percentile(0.99) << "ns; p99.9: " << percentile(0.999) << "ns\n";
+    }
+}
+
+TEST_CASE("q_msg consumer - mutex queue vs spsc drain", "[.][benchmark]")
+{
+    constexpr size_t NO_OF_MSGS = 1'000'000;
+    constexpr size_t BATCH_SIZE = 256;
+
+    auto produce = [](auto& q) {
+        for (size_t i = 0; i < NO_OF_MSGS; ++i)
+            while (!q.try_push(TimestampedMessage{std::chrono::steady_clock::now(), "MSG"}))
+                std::this_thread::yield();
+    };
+
+    {
+        MutexQueue<TimestampedMessage> q_msg;
+        std::vector<std::chrono::nanoseconds> latencies;
+        latencies.reserve(NO_OF_MSGS);
+
+        const auto start = std::chrono::steady_clock::now();
+        std::thread producer{[&] { produce(q_msg); }};
+
+        while (latencies.size() < NO_OF_MSGS)
+        {
+            if (auto msg = q_msg.try_pop(); msg)
+                latencies.push_back(std::chrono::steady_clock::now() - msg->sent);
+            else
+                std::this_thread::yield();
+        }
+
+        producer.join();
+        print_latency_report("std::queue + std::mutex", latencies, std::chrono::steady_clock::now() - start);
+    }
+
+    {
+        SpscQueue<TimestampedMessage> q_msg{4096};
+        std::vector<std::chrono::nanoseconds> latencies;
+        latencies.reserve(NO_OF_MSGS);
+
+        const auto start = std::chrono::steady_clock::now();
+        std::thread producer{[&] { produce(q_msg); }};
+
+        while (latencies.size() < NO_OF_MSGS)
+        {
+            const auto no_of_drained = q_msg.drain(BATCH_SIZE, [&latencies](TimestampedMessage&& msg) {
+                latencies.push_back(std::chrono::steady_clock::now() - msg.sent);
+            });
+
+            if (no_of_drained == 0)
+                std::this_thread::yield();
+        }
+
+        producer.join();
+        print_latency_report("SpscQueue::drain", latencies, std::chrono::steady_clock::now() - start);
+    }
+}
+
+TEST_CASE("idle consumer - sleep-polling vs spin-then-park", "[.][benchmark]")
+{
+    using namespace std::chrono_literals;
+
+    constexpr int NO_OF_MSGS = 200;
+    static constexpr auto IDLE_GAP = 2ms;
+
+    // producer sends a message after each idle gap; consumer reports wake-up latency
+    auto run = [](const std::string& name, auto& q, auto wait_for_msg) {
+        std::vector<std::chrono::nanoseconds> latencies;
+        latencies.reserve(NO_OF_MSGS);
+
+        const auto cpu_start = std::clock();
+        const auto start = std::chrono::steady_clock::now();
+
+        std::thread producer{[&q] {
+            for (int i = 0; i < NO_OF_MSGS; ++i)
+            {
+                std::this_thread::sleep_for(IDLE_GAP);
+                q.push(TimestampedMessage{std::chrono::steady_clock::now(), "MSG"});
+            }
+        }};
+
+        for (int i = 0; i < NO_OF_MSGS; ++i)
+        {
+            const auto msg = wait_for_msg(q);
+            latencies.push_back(std::chrono::steady_clock::now() - msg.sent);
+        }
+
+        producer.join();
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const auto cpu_time = std::chrono::duration<double>(static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC);
+
+        print_latency_report(name, latencies, elapsed);
+        std::cout << name << " - CPU usage: " << 100.0 * cpu_time / elapsed << "% of one core\n";
+    };
+
+    {
+        MutexQueue<TimestampedMessage> q_msg;
+        run("sleep-polling (1ms)", q_msg, [](auto& q) {
+            while (true)
+            {
+                if (auto msg = q.try_pop(); msg)
+                    return std::move(*msg);
+                std::this_thread::sleep_for(1ms);
+            }
+        });
+    }
+
+    {
+        BlockingQueue<TimestampedMessage> q_msg;
+        run("BlockingQueue - spin then park", q_msg, [](auto& q) { return *q.pop(); });
+    }
+
+    {
+        BlockingQueue<TimestampedMessage> q_msg{0};
+        run("BlockingQueue - park only", q_msg, [](auto& q) { return *q.pop(); });
+    }
+}
@@ -0,0 +1,376 @@
+#ifndef TRANSACTION_JOURNAL_HPP
+#define TRANSACTION_JOURNAL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bank_account.hpp"
+
+// journal is flushed once per batch_size records or once per window - whichever comes first
+struct GroupCommit
+{
+    std::uint64_t batch_size = 4096;
+    std::chrono::milliseconds window{10};
+};
+
+// Append-only journal of fixed-size records in a memory-mapped file (POSIX)
+// - append() only copies a record into the mapping - no syscall per operation
+// - group commit: a flusher thread msyncs the pages of new records once per batch_size records
+//   (append() only wakes it up) or once per time window, whichever comes first
+// - records appended since the last flush may be lost on a crash; sync() forces a flush
+class TransactionJournal : public TransactionLog
+{
+public:
+    struct Record
+    {
+        std::atomic<std::uint64_t> seq_no; // 0 - empty slot; stored last (release) - marks the record as complete
+        Operation op;
+        std::int32_t account_id;
+        std::int32_t to_account_id;
+        std::int32_t reserved;
+        double amount;
+    };
+
+    static_assert(sizeof(Record) == 32);
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "seq_no is shared through the file mapping");
+
+private:
+    struct FileHeader
+    {
+        char magic[8];
+        std::uint64_t capacity;
+        std::uint64_t record_size;
+        std::uint64_t reserved;
+    };
+
+    static constexpr char file_magic[8] = {'B', 'A', 'N', 'K', 'J', 'R', 'N', '1'};
+
+    int fd_ = -1;
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+    FileHeader* header_ = nullptr;
+    Record* records_ = nullptr;
+
+    GroupCommit group_commit_;
+    std::atomic<std::uint64_t> next_slot_{0};
+    std::atomic<std::uint64_t> flushed_{0};
+    std::mutex mtx_flush_;
+    std::exception_ptr flush_error_; // error of the flusher thread - guarded by mtx_flush_
+    std::atomic<bool> has_flush_error_{false};
+
+    bool stop_flusher_ = false;
+    std::atomic<bool> flush_requested_{false};
+    std::mutex mtx_flusher_;
+    std::condition_variable cv_flusher_;
+    std::thread flusher_;
+
+    [[noreturn]] static void throw_system_error(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    static std::size_t mapping_size_for(std::uint64_t capacity)
+    {
+        return sizeof(FileHeader) + capacity * sizeof(Record);
+    }
+
+    static std::size_t record_offset(std::uint64_t slot)
+    {
+        return sizeof(FileHeader) + slot * sizeof(Record);
+    }
+
+    // caller must hold mtx_flush_
+    void flush_locked()
+    {
+        // slots are reserved before they are written - flush only up to the first record that is not complete yet
+        const auto reserved = std::min(next_slot_.load(std::memory_order_acquire), header_->capacity);
+        const auto from = flushed_.load(std::memory_order_relaxed);
+        auto upto = from;
+        while (upto < reserved && records_[upto].seq_no.load(std::memory_order_acquire) == upto + 1)
+            ++upto;
+
+        if (upto == from)
+            return;
+
+        // only the pages of records appended since the last flush
+        static const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const auto begin = record_offset(from) / page_size * page_size;
+        const auto end = record_offset(upto);
+
+        if (::msync(static_cast<char*>(mapping_) + begin, end - begin, MS_SYNC) != 0)
+            throw_system_error("msync failed");
+
+        flushed_.store(upto, std::memory_order_release);
+    }
+
+    void run_flusher()
+    {
+        std::unique_lock lk{mtx_flusher_};
+        while (!stop_flusher_)
+        {
+            cv_flusher_.wait_for(lk, group_commit_.window, [this] { return stop_flusher_ || flush_requested_.load(); });
+            flush_requested_ = false;
+
+            std::lock_guard lk_flush{mtx_flush_};
+            try
+            {
+                flush_locked();
+            }
+            catch (...)
+            {
+                flush_error_ = std::current_exception(); // reported by the next append() or sync()
+                has_flush_error_.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+    // caller must hold mtx_flush_
+    void rethrow_flush_error_locked()
+    {
+        if (!flush_error_)
+            return;
+
+        has_flush_error_.store(false, std::memory_order_relaxed);
+        std::rethrow_exception(std::exchange(flush_error_, nullptr));
+    }
+
+    void unmap() noexcept
+    {
+        if (mapping_)
+            ::munmap(mapping_, mapping_size_);
+        if (fd_ != -1)
+            ::close(fd_);
+    }
+
+public:
+    // opens (or creates) the journal - appending continues after the last record found in the file
+    TransactionJournal(const std::string& path, std::uint64_t capacity, GroupCommit group_commit = {})
+        : group_commit_{group_commit}
+    {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ == -1)
+            throw_system_error("cannot open journal " + path);
+
+        struct stat file_stat{};
+        if (::fstat(fd_, &file_stat) != 0)
+        {
+            unmap();
+            throw_system_error("cannot stat journal " + path);
+        }
+
+        const bool is_new_file = file_stat.st_size == 0;
+
+        if (!is_new_file)
+        {
+            FileHeader existing_header{};
+            if (::pread(fd_, &existing_header, sizeof(existing_header), 0) != sizeof(existing_header)
+                || std::memcmp(existing_header.magic, file_magic, sizeof(file_magic)) != 0)
+            {
+                unmap();
+                throw std::runtime_error("not a transaction journal: " + path);
+            }
+            capacity = existing_header.capacity;
+
+            if (static_cast<std::uint64_t>(file_stat.st_size) < mapping_size_for(capacity))
+            {
+                unmap();
+                throw std::runtime_error("truncated transaction journal: " + path);
+            }
+        }
+
+        mapping_size_ = mapping_size_for(capacity);
+        if (is_new_file && ::ftruncate(fd_, static_cast<off_t>(mapping_size_)) != 0)
+        {
+            unmap();
+            throw_system_error("cannot resize journal " + path);
+        }
+
+        mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapping_ == MAP_FAILED)
+        {
+            mapping_ = nullptr;
+            unmap();
+            throw_system_error("cannot map journal " + path);
+        }
+
+        header_ = static_cast<FileHeader*>(mapping_);
+        records_ = reinterpret_cast<Record*>(static_cast<char*>(mapping_) + sizeof(FileHeader));
+
+        if (is_new_file)
+        {
+            std::memcpy(header_->magic, file_magic, sizeof(file_magic));
+            header_->capacity = capacity;
+            header_->record_size = sizeof(Record);
+
+            if (::msync(mapping_, sizeof(FileHeader), MS_SYNC) != 0)
+            {
+                unmap();
+                throw_system_error("cannot flush journal header " + path);
+            }
+        }
+
+        std::uint64_t size = 0;
+        while (size < capacity && records_[size].seq_no.load(std::memory_order_relaxed) == size + 1)
+            ++size;
+        next_slot_ = size;
+        flushed_ = size;
+
+        flusher_ = std::thread{&TransactionJournal::run_flusher, this};
+    }
+
+    TransactionJournal(const TransactionJournal&) = delete;
+    TransactionJournal& operator=(const TransactionJournal&) = delete;
+
+    ~TransactionJournal() override
+    {
+        {
+            std::lock_guard lk{mtx_flusher_};
+            stop_flusher_ = true;
+        }
+        cv_flusher_.notify_one();
+        flusher_.join();
+
+        try
+        {
+            sync();
+        }
+        catch (...)
+        {
+        }
+
+        unmap();
+    }
+
+    // throws the error of a failed background flush (once)
+    void append(Operation op, int account_id, double amount, int to_account_id = 0) override
+    {
+        if (has_flush_error_.load(std::memory_order_acquire))
+        {
+            std::lock_guard lk{mtx_flush_};
+            rethrow_flush_error_locked();
+        }
+
+        const auto slot = next_slot_.fetch_add(1, std::memory_order_relaxed);
+        if (slot >= header_->capacity)
+            throw std::length_error("transaction journal is full");
+
+        Record& record = records_[slot];
+        record.op = op;
+        record.account_id = account_id;
+        record.to_account_id = to_account_id;
+        record.reserved = 0;
+        record.amount = amount;
+        record.seq_no.store(slot + 1, std::memory_order_release);
+
+        // append() may run under an account lock - the flush itself is done by the flusher thread
+        // (a wake-up lost between its check & wait only delays the flush until the end of the window)
+        if (slot + 1 - flushed_.load(std::memory_order_relaxed) >= group_commit_.batch_size && !flush_requested_.exchange(true))
+            cv_flusher_.notify_one();
+    }
+
+    // flushes all complete records - throws the error of a failed background flush (once)
+    void sync()
+    {
+        std::lock_guard lk{mtx_flush_};
+        rethrow_flush_error_locked();
+        flush_locked();
+    }
+
+    std::uint64_t size() const
+    {
+        return std::min(next_slot_.load(std::memory_order_relaxed), header_->capacity);
+    }
+
+    std::uint64_t capacity() const
+    {
+        return header_->capacity;
+    }
+
+    // number of records known to be on disk (all records before the first incomplete one)
+    std::uint64_t flushed() const
+    {
+        return flushed_.load(std::memory_order_acquire);
+    }
+
+    // rebuilds balances (account id -> balance) from the records of the journal
+    static std::map<int, double> replay(const std::string& path)
+    {
+        std::map<int, double> balances;
+
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            if (errno == ENOENT)
+                return balances;
+            throw_system_error("cannot open journal " + path);
+        }
+
+        struct stat file_stat{};
+        if (::fstat(fd, &file_stat) != 0 || static_cast<std::size_t>(file_stat.st_size) < sizeof(FileHeader))
+        {
+            ::close(fd);
+            throw std::runtime_error("not a transaction journal: " + path);
+        }
+
+        const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+        void* mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+            throw_system_error("cannot map journal " + path);
+
+        const auto* header = static_cast<const FileHeader*>(mapping);
+        const auto* records = reinterpret_cast<const Record*>(static_cast<const char*>(mapping) + sizeof(FileHeader));
+        const auto capacity = std::min<std::uint64_t>(header->capacity, (file_size - sizeof(FileHeader)) / sizeof(Record));
+
+        if (std::memcmp(header->magic, file_magic, sizeof(file_magic)) != 0)
+        {
+            ::munmap(mapping, file_size);
+            throw std::runtime_error("not a transaction journal: " + path);
+        }
+
+        for (std::uint64_t i = 0; i < capacity && records[i].seq_no.load(std::memory_order_relaxed) == i + 1; ++i)
+        {
+            const Record& record = records[i];
+            switch (record.op)
+            {
+            case Operation::open:
+                balances[record.account_id] = record.amount;
+                break;
+            case Operation::deposit:
+                balances[record.account_id] += record.amount;
+                break;
+            case Operation::withdraw:
+                balances[record.account_id] -= record.amount;
+                break;
+            case Operation::transfer:
+                balances[record.account_id] -= record.amount;
+                balances[record.to_account_id] += record.amount;
+                break;
+            }
+        }
+
+        ::munmap(mapping, file_size);
+
+        return balances;
+    }
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef TRANSFER_BATCH_HPP
+#define TRANSFER_BATCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Applies many transfers at once: transfers are netted per account and every account
+// is touched only once (one lock acquisition for BankAccount)
+// - amounts are netted in double, in the order of the records - for an account starting from zero
+//   the final balance is bit-identical to applying the transfers one by one (otherwise equal up to rounding)
+// - the batch is not atomic as a whole - other threads may observe partially applied batch
+template <typename TAccount>
+class TransferBatch
+{
+public:
+    struct Record
+    {
+        TAccount* from;
+        TAccount* to;
+        double amount;
+    };
+
+private:
+    std::vector<std::pair<TAccount*, double>> deltas_; // reused between batches
+
+public:
+    void apply(const Record* records, std::size_t count)
+    {
+        deltas_.clear();
+        deltas_.reserve(2 * count);
+
+        for (const Record* rec = records; rec != records + count; ++rec)
+        {
+            deltas_.emplace_back(rec->from, -rec->amount);
+            deltas_.emplace_back(rec->to, rec->amount);
+        }
+
+        // group by account - only one account is locked at a time, so the order only has to be deterministic
+        // - the pointer breaks ties between accounts with the same id; stable sort keeps the order of records
+        std::stable_sort(begin(deltas_), end(deltas_), [](const auto& a, const auto& b) {
+            const auto id_a = a.first->id();
+            const auto id_b = b.first->id();
+            return id_a < id_b || (id_a == id_b && std::less<TAccount*>{}(a.first, b.first));
+        });
+
+        for (auto it = begin(deltas_); it != end(deltas_);)
+        {
+            TAccount* account = it->first;
+            double net = 0.0;
+
+            for (; it != end(deltas_) && it->first == account; ++it)
+                net += it->second;
+
+            if (net > 0.0)
+                account->deposit(net);
+            else if (net < 0.0)
+                account->withdraw(-net);
+        }
+    }
+
+    template <typename TRecords>
+    void apply(const TRecords& records)
+    {
+        apply(std::data(records), std::size(records));
+    }
+};
+
+#endif